@@ -0,0 +1,454 @@
+#ifndef THZ_AUTOGAMING_BENCHMARK_FALLBACK_BENCHMARK_H
+#define THZ_AUTOGAMING_BENCHMARK_FALLBACK_BENCHMARK_H
+
+// Minimal stand-in for Google Benchmark, only used if the library is not available when configuring the project.
+// Supports the subset of the API used by the benchmarks of this project and writes the results using the same JSON
+// layout as Google Benchmark, so results of both can be tracked by the same tools.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace benchmark {
+
+/// @brief The type used for counting iterations.
+using IterationCount = std::int64_t;
+
+/// @brief Prevents the compiler from optimizing away the computation of the given value.
+///
+/// @param value The value to keep.
+template <typename TValue>
+inline void DoNotOptimize(TValue const &value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static void const *volatile sink{};
+    sink = &value;
+#endif
+}
+
+/// @brief Provides the arguments of a benchmark run and controls its iterations and timing.
+class State
+{
+public:
+    /// @brief Iterator driving the range based for loop over the state.
+    class Iterator
+    {
+    public:
+        /// @brief Dummy value returned for each iteration.
+#if defined(__GNUC__) || defined(__clang__)
+        struct __attribute__((unused)) Value
+#else
+        struct Value
+#endif
+        {};
+
+        Iterator(State *const parent, IterationCount const remaining) noexcept
+            : _parent{parent}, _remaining{remaining}
+        {}
+
+        Value operator*() const noexcept { return {}; }
+
+        Iterator &operator++() noexcept
+        {
+            --_remaining;
+            return *this;
+        }
+
+        bool operator!=(Iterator const &) noexcept
+        {
+            if (_remaining != 0)
+            {
+                return true;
+            }
+            _parent->PauseTiming();
+            return false;
+        }
+
+    private:
+        State *_parent;
+
+        IterationCount _remaining;
+    };
+
+    /// @brief Initializes a new State.
+    ///
+    /// @param arguments The arguments of the run.
+    /// @param iterations The number of iterations to run.
+    State(std::vector<std::int64_t> const &arguments, IterationCount const iterations) noexcept
+        : _arguments{arguments}, _iterations{iterations}
+    {}
+
+    /// @brief Returns the argument at the given index.
+    ///
+    /// @param index The index of the argument.
+    /// @return The argument, 0 if there is no argument for the index.
+    std::int64_t range(size_t const index = 0U) const noexcept
+    {
+        return index < _arguments.size() ? _arguments[index] : 0;
+    }
+
+    /// @brief Returns the number of iterations of the run.
+    ///
+    /// @return The number of iterations of the run.
+    IterationCount iterations() const noexcept { return _iterations; }
+
+    /// @brief Sets the number of items processed by the run, used to calculate the throughput.
+    ///
+    /// @param items The number of items processed.
+    void SetItemsProcessed(std::int64_t const items) noexcept { _items = items; }
+
+    /// @brief Returns the number of items processed by the run.
+    ///
+    /// @return The number of items processed by the run.
+    std::int64_t items_processed() const noexcept { return _items; }
+
+    /// @brief Stops the timers until ResumeTiming is called.
+    void PauseTiming() noexcept
+    {
+        if (_running)
+        {
+            _realTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - _realStart).count();
+            _cpuTime += static_cast<double>(std::clock() - _cpuStart) / CLOCKS_PER_SEC;
+            _running = false;
+        }
+    }
+
+    /// @brief Restarts the timers after PauseTiming was called.
+    void ResumeTiming() noexcept
+    {
+        if (!_running)
+        {
+            _running   = true;
+            _cpuStart  = std::clock();
+            _realStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    Iterator begin() noexcept
+    {
+        ResumeTiming();
+        return Iterator{this, _iterations};
+    }
+
+    Iterator end() noexcept { return Iterator{this, 0}; }
+
+    /// @brief Returns the measured wall clock time [s].
+    ///
+    /// @return The measured wall clock time.
+    double realTime() const noexcept { return _realTime; }
+
+    /// @brief Returns the measured processor time of the process [s].
+    ///
+    /// @return The measured processor time of the process.
+    double cpuTime() const noexcept { return _cpuTime; }
+
+private:
+    std::vector<std::int64_t> _arguments;
+
+    IterationCount _iterations;
+
+    std::int64_t _items{};
+
+    bool _running{};
+
+    double _realTime{};
+
+    double _cpuTime{};
+
+    std::clock_t _cpuStart{};
+
+    std::chrono::steady_clock::time_point _realStart{};
+};
+
+namespace internal {
+
+/// @brief A registered benchmark and the argument sets it is run with.
+class Benchmark
+{
+public:
+    /// @brief The type of function implementing the benchmark.
+    using Function = void (*)(State &);
+
+    Benchmark(std::string name, Function const function) noexcept : _name{std::move(name)}, _function{function} {}
+
+    /// @brief Adds a run with a single argument.
+    Benchmark *Arg(std::int64_t const argument) noexcept
+    {
+        _arguments.push_back({argument});
+        return this;
+    }
+
+    /// @brief Adds a run with multiple arguments.
+    Benchmark *Args(std::vector<std::int64_t> const &arguments) noexcept
+    {
+        _arguments.push_back(arguments);
+        return this;
+    }
+
+    /// @brief Determines the iterations using the wall clock, which this harness always does.
+    Benchmark *UseRealTime() noexcept { return this; }
+
+    std::string const &name() const noexcept { return _name; }
+
+    Function function() const noexcept { return _function; }
+
+    std::vector<std::vector<std::int64_t>> const &arguments() const noexcept { return _arguments; }
+
+private:
+    std::string _name;
+
+    Function _function;
+
+    std::vector<std::vector<std::int64_t>> _arguments{};
+};
+
+/// @brief Returns the list of all registered benchmarks.
+inline std::vector<std::unique_ptr<Benchmark>> &registry() noexcept
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks{};
+    return benchmarks;
+}
+
+/// @brief The options given on the command line.
+struct Options
+{
+    std::string filter{"."};
+
+    std::string out{};
+
+    std::string format{"console"};
+
+    double minTime{0.5};
+};
+
+inline Options &options() noexcept
+{
+    static Options opts{};
+    return opts;
+}
+
+/// @brief The result of a single benchmark run.
+struct Result
+{
+    std::string name;
+
+    IterationCount iterations;
+
+    double realTime;
+
+    double cpuTime;
+
+    std::int64_t items;
+};
+
+/// @brief Escapes the given string for use in JSON.
+inline std::string escape(std::string_view const text) noexcept
+{
+    std::string result{};
+    for (auto const c : text)
+    {
+        if ((c == '"') || (c == '\\'))
+        {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+
+/// @brief Writes the given results in the JSON format of Google Benchmark.
+inline void writeJson(std::ostream &stream, std::string_view const executable, std::vector<Result> const &results)
+{
+    auto const now = std::time(nullptr);
+    char       date[32]{};
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    stream << "{\n  \"context\": {\n";
+    stream << "    \"date\": \"" << date << "\",\n";
+    stream << "    \"executable\": \"" << escape(executable) << "\",\n";
+    stream << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    stream << "    \"library_version\": \"fallback\"\n  },\n";
+    stream << "  \"benchmarks\": [";
+    for (size_t i = 0U; i < results.size(); ++i)
+    {
+        auto const &result = results[i];
+        auto const  count  = static_cast<double>(result.iterations);
+        stream << (i == 0U ? "\n" : ",\n") << "    {\n";
+        stream << "      \"name\": \"" << escape(result.name) << "\",\n";
+        stream << "      \"run_name\": \"" << escape(result.name) << "\",\n";
+        stream << "      \"run_type\": \"iteration\",\n";
+        stream << "      \"iterations\": " << result.iterations << ",\n";
+        stream << "      \"real_time\": " << (result.realTime * 1e9 / count) << ",\n";
+        stream << "      \"cpu_time\": " << (result.cpuTime * 1e9 / count) << ",\n";
+        stream << "      \"time_unit\": \"ns\"";
+        if ((result.items != 0) && (result.realTime > 0.0))
+        {
+            stream << ",\n      \"items_per_second\": " << (static_cast<double>(result.items) / result.realTime);
+        }
+        stream << "\n    }";
+    }
+    stream << "\n  ]\n}\n";
+}
+
+/// @brief Returns the name of the run of the given benchmark with the given arguments.
+inline std::string runName(Benchmark const &benchmark, std::vector<std::int64_t> const &arguments)
+{
+    std::string name{benchmark.name()};
+    for (auto const argument : arguments)
+    {
+        name += '/' + std::to_string(argument);
+    }
+    return name;
+}
+
+/// @brief Runs the given benchmark with the given arguments until the minimum time is reached.
+inline Result run(Benchmark const &benchmark, std::vector<std::int64_t> const &arguments, std::string const &name)
+{
+    auto const     minTime = options().minTime;
+    IterationCount iterations{1};
+    while (true)
+    {
+        State state{arguments, iterations};
+        benchmark.function()(state);
+        auto const time = state.realTime();
+        if ((time >= minTime) || (iterations >= 1'000'000'000))
+        {
+            return Result{name, iterations, time, state.cpuTime(), state.items_processed()};
+        }
+        // aim a bit above the minimum time, but grow by at most ten times per round
+        auto const factor = time > 0.0 ? std::min(10.0, 1.4 * minTime / time) : 10.0;
+        iterations        = std::max(iterations + 1, static_cast<IterationCount>(iterations * factor));
+    }
+}
+
+} // namespace internal
+
+/// @brief Registers a new benchmark.
+///
+/// @param name The name of the benchmark.
+/// @param function The function implementing the benchmark.
+/// @return The registered benchmark, used for adding arguments.
+inline internal::Benchmark *RegisterBenchmark(char const *const name, internal::Benchmark::Function const function)
+{
+    auto &benchmarks = internal::registry();
+    benchmarks.emplace_back(std::make_unique<internal::Benchmark>(name, function));
+    return benchmarks.back().get();
+}
+
+/// @brief Parses the supported command line arguments.
+///
+/// @remarks Supported are --benchmark_filter=<regex>, --benchmark_min_time=<seconds>, --benchmark_format=json|console
+/// and --benchmark_out=<file>, the later always writes JSON.
+inline void Initialize(int *argc, char **argv)
+{
+    auto &opts = internal::options();
+    for (auto i = 1; i < *argc; ++i)
+    {
+        std::string_view const argument{argv[i]};
+        auto const             read = [&](std::string_view const flag, std::string &target) noexcept -> bool {
+            if (!argument.starts_with(flag) || (argument.size() <= flag.size()) || (argument[flag.size()] != '='))
+            {
+                return false;
+            }
+            target = argument.substr(flag.size() + 1U);
+            return true;
+        };
+        std::string minTime{};
+        if (read("--benchmark_min_time", minTime))
+        {
+            opts.minTime = std::stod(minTime);
+        }
+        else if (!read("--benchmark_filter", opts.filter) && !read("--benchmark_out", opts.out) &&
+                 !read("--benchmark_format", opts.format))
+        {
+            std::cerr << "unrecognized argument: " << argument << '\n';
+        }
+    }
+}
+
+/// @brief Runs all registered benchmarks matching the filter and reports the results.
+///
+/// @param executable The name of the executable, written to the JSON context.
+/// @return The number of benchmarks run.
+inline size_t RunSpecifiedBenchmarks(std::string_view const executable = {})
+{
+    auto const &opts = internal::options();
+    std::regex  filter{opts.filter};
+    auto const  json = opts.format == "json";
+
+    std::vector<internal::Result> results{};
+    for (auto const &benchmark : internal::registry())
+    {
+        auto arguments = benchmark->arguments();
+        if (arguments.empty())
+        {
+            arguments.emplace_back();
+        }
+        for (auto const &args : arguments)
+        {
+            auto const name = internal::runName(*benchmark, args);
+            if (!std::regex_search(name, filter))
+            {
+                continue;
+            }
+            results.push_back(internal::run(*benchmark, args, name));
+            if (!json)
+            {
+                auto const &result = results.back();
+                auto const  count  = static_cast<double>(result.iterations);
+                std::printf("%-60s %13.1f ns %13.1f ns %12lld\n",
+                            result.name.c_str(),
+                            result.realTime * 1e9 / count,
+                            result.cpuTime * 1e9 / count,
+                            static_cast<long long>(result.iterations));
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    if (json)
+    {
+        internal::writeJson(std::cout, executable, results);
+    }
+    if (!opts.out.empty())
+    {
+        std::ofstream file{opts.out};
+        internal::writeJson(file, executable, results);
+    }
+    return results.size();
+}
+
+} // namespace benchmark
+
+#define BENCHMARK_PRIVATE_CONCAT2(a, b) a##b
+#define BENCHMARK_PRIVATE_CONCAT(a, b) BENCHMARK_PRIVATE_CONCAT2(a, b)
+#define BENCHMARK_PRIVATE_DECLARE(n)                                                                                   \
+    static ::benchmark::internal::Benchmark *BENCHMARK_PRIVATE_CONCAT(benchmark_uniq_, __COUNTER__)
+
+#define BENCHMARK(n) BENCHMARK_PRIVATE_DECLARE(n) = ::benchmark::RegisterBenchmark(#n, n)
+
+#define BENCHMARK_TEMPLATE(n, ...)                                                                                     \
+    BENCHMARK_PRIVATE_DECLARE(n) = ::benchmark::RegisterBenchmark(#n "<" #__VA_ARGS__ ">", n<__VA_ARGS__>)
+
+#define BENCHMARK_MAIN()                                                                                               \
+    int main(int argc, char **argv)                                                                                    \
+    {                                                                                                                  \
+        ::benchmark::Initialize(&argc, argv);                                                                          \
+        ::benchmark::RunSpecifiedBenchmarks(argv[0]);                                                                  \
+        return 0;                                                                                                      \
+    }                                                                                                                  \
+    int main(int, char **)
+
+#endif // !THZ_AUTOGAMING_BENCHMARK_FALLBACK_BENCHMARK_H
@@ -0,0 +1,135 @@
+#include "THzAutoGaming/input/emulator.hpp"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace Terrahertz::Benchmarks {
+namespace {
+
+using Ms = std::chrono::milliseconds;
+
+/// @brief Deviation strategy without any delays, so the emulator performs the actions as fast as possible.
+struct ImmediateStrategy : public Input::IDeviationStrategy
+{
+    Ms calculateKeyDownTime() noexcept override { return Ms{0}; }
+
+    Ms calculateKeyUpTime() noexcept override { return Ms{0}; }
+
+    Ms calculateButtonDownTime() noexcept override { return Ms{0}; }
+
+    Ms calculateButtonUpTime() noexcept override { return Ms{0}; }
+
+    Point calculateTargetIn(Rectangle const &area) noexcept override { return Point{}; }
+
+    std::uint32_t calculateSpeed() noexcept override { return 1000U; }
+
+    double calculateHorizontalSpeedFactor() noexcept override { return 1.0; }
+
+    std::int16_t calculateWheelSteps(std::int16_t const remainingSteps) noexcept override { return remainingSteps; }
+
+    std::uint16_t calculateWheelSpeed() noexcept override { return 1000U; }
+
+    Ms calculateWheelResetTime() noexcept override { return Ms{0}; }
+};
+
+/// @brief System interface accepting all inputs without passing them on to the system.
+struct FakeSystemInterface
+{
+    bool isDown(Input::MouseButton const) noexcept { return false; }
+
+    bool isDown(Input::Key const) noexcept { return false; }
+
+    bool isActive(Input::KeyboardLock const) noexcept { return false; }
+
+    bool getCursorPosition(std::uint32_t &x, std::uint32_t &y) noexcept
+    {
+        x = cursorX;
+        y = cursorY;
+        return true;
+    }
+
+    bool setCursorPosition(std::uint32_t const x, std::uint32_t const y) noexcept
+    {
+        cursorX = x;
+        cursorY = y;
+        return true;
+    }
+
+    bool turnMouseWheel(std::int16_t const) noexcept { return true; }
+
+    bool down(Input::MouseButton const) noexcept { return true; }
+
+    bool up(Input::MouseButton const) noexcept { return true; }
+
+    bool down(Input::Key const) noexcept { return true; }
+
+    bool up(Input::Key const) noexcept { return true; }
+
+    std::uint32_t cursorX{};
+
+    std::uint32_t cursorY{};
+};
+
+using FakeEmulator = Input::BaseEmulator<FakeSystemInterface>;
+
+void EmulatorEnqueueAndClear(benchmark::State &state)
+{
+    auto const        count = state.range(0);
+    ImmediateStrategy strategy{};
+    FakeEmulator      emulator{&strategy};
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            emulator.press(Input::Key::Space);
+        }
+        emulator.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(EmulatorEnqueueAndClear)->Arg(16)->Arg(256);
+
+void EmulatorKeyboardThroughput(benchmark::State &state)
+{
+    auto const        count = state.range(0);
+    ImmediateStrategy strategy{};
+    FakeEmulator      emulator{&strategy};
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            emulator.press(Input::Key::Space);
+        }
+        while (emulator.actionCountKeyboard() != 0U)
+        {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(EmulatorKeyboardThroughput)->Arg(16)->Arg(256);
+
+void EmulatorMouseThroughput(benchmark::State &state)
+{
+    auto const        count = state.range(0);
+    ImmediateStrategy strategy{};
+    FakeEmulator      emulator{&strategy};
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            emulator.click(Input::MouseButton::Left);
+        }
+        while (emulator.actionCountMouse() != 0U)
+        {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(EmulatorMouseThroughput)->Arg(16)->Arg(256);
+
+} // namespace
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,343 @@
+#include "THzAutoGaming/optimisation/evolution/algorithm.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+namespace {
+
+/// @brief Individual searching for a point close to the origin, cheap enough to measure the algorithm itself.
+struct PointIndividual
+{
+    void init(std::default_random_engine &rng) noexcept
+    {
+        std::uniform_real_distribution<double> distribution{-1.0, 1.0};
+        for (auto &coordinate : coordinates)
+        {
+            coordinate = distribution(rng);
+        }
+    }
+
+    void reproduce(PointIndividual const      &parentA,
+                   PointIndividual const      &parentB,
+                   std::default_random_engine &rng) noexcept
+    {
+        for (auto i = 0U; i < coordinates.size(); ++i)
+        {
+            coordinates[i] = (parentA.coordinates[i] + parentB.coordinates[i]) * 0.5;
+        }
+    }
+
+    void mutate(PointIndividual const &parent, std::default_random_engine &rng) noexcept
+    {
+        std::normal_distribution<double> distribution{0.0, 0.1};
+        for (auto i = 0U; i < coordinates.size(); ++i)
+        {
+            coordinates[i] = parent.coordinates[i] + distribution(rng);
+        }
+    }
+
+    bool save(std::ofstream &file) const noexcept
+    {
+        return static_cast<bool>(file.write(reinterpret_cast<char const *>(coordinates.data()), sizeof(coordinates)));
+    }
+
+    bool load(std::ifstream &file) noexcept
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(coordinates.data()), sizeof(coordinates)));
+    }
+
+    std::array<double, 8U> coordinates{};
+};
+
+struct PointEvaluator
+{
+    double operator()(PointIndividual const &individual) noexcept
+    {
+        auto sum = 0.0;
+        for (auto const coordinate : individual.coordinates)
+        {
+            sum += coordinate * coordinate;
+        }
+        return -sum;
+    }
+};
+
+/// @brief Evaluator spending noticeable time on each individual, like the game rollouts used in practice.
+struct RolloutEvaluator
+{
+    double operator()(PointIndividual const &individual) noexcept
+    {
+        auto sum = 0.0;
+        for (auto rollout = 0U; rollout < 1000U; ++rollout)
+        {
+            for (auto const coordinate : individual.coordinates)
+            {
+                sum += std::sqrt((coordinate * coordinate) + rollout);
+            }
+        }
+        return -sum;
+    }
+};
+
+/// @brief Individual without any work, so the algorithm only spends time on refilling and selecting.
+struct NoopIndividual
+{
+    void init() noexcept {}
+
+    void reproduce(NoopIndividual const &parentA, NoopIndividual const &parentB) noexcept {}
+
+    void mutate(NoopIndividual const &parent) noexcept {}
+
+    bool save(std::ofstream &file) const noexcept { return false; }
+
+    bool load(std::ifstream &file) noexcept { return false; }
+};
+
+/// @brief Individual carrying a kilobyte genome without any work, like the large genomes of game agents.
+struct KilobyteIndividual
+{
+    void init() noexcept {}
+
+    void reproduce(KilobyteIndividual const &parentA, KilobyteIndividual const &parentB) noexcept {}
+
+    void mutate(KilobyteIndividual const &parent) noexcept {}
+
+    bool save(std::ofstream &file) const noexcept { return false; }
+
+    bool load(std::ifstream &file) noexcept { return false; }
+
+    std::array<std::uint8_t, 1024U> genome{};
+};
+
+/// @brief Evaluator returning pseudo-random fitness values, so the tournaments have distinct winners.
+struct HashEvaluator
+{
+    template <typename TIndividual>
+    double operator()(TIndividual const &individual) noexcept
+    {
+        state = (state * 6364136223846793005ULL) + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11U);
+    }
+
+    std::uint64_t state{};
+};
+
+/// @brief Evaluator returning two pseudo-random objectives, so the population spreads over many fronts.
+struct HashObjectivesEvaluator
+{
+    template <typename TIndividual>
+    std::array<double, 2U> operator()(TIndividual const &individual) noexcept
+    {
+        return {hash(individual), hash(individual)};
+    }
+
+    HashEvaluator hash{};
+};
+
+using PointAlgorithm = Optimisation::Evolution::Algorithm<PointIndividual, PointEvaluator>;
+
+using RolloutAlgorithm = Optimisation::Evolution::Algorithm<PointIndividual, RolloutEvaluator>;
+
+using NoopAlgorithm = Optimisation::Evolution::Algorithm<NoopIndividual, HashEvaluator>;
+
+using KilobyteAlgorithm = Optimisation::Evolution::Algorithm<KilobyteIndividual, HashEvaluator>;
+
+using ParetoAlgorithm = Optimisation::Evolution::Algorithm<NoopIndividual, HashObjectivesEvaluator>;
+
+void EvolutionAlgorithmRunOnce(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = static_cast<std::uint32_t>(state.range(0));
+    parameters.survivors  = parameters.population * 3U / 10U;
+
+    PointAlgorithm algorithm{};
+    algorithm.setParameters(parameters);
+    // the first generation initializes the whole population, every further one refills the losers
+    algorithm.runOnce();
+    for (auto _ : state)
+    {
+        algorithm.runOnce();
+        benchmark::DoNotOptimize(algorithm.generation());
+    }
+    state.SetItemsProcessed(state.iterations() * (parameters.population - parameters.survivors));
+}
+BENCHMARK(EvolutionAlgorithmRunOnce)->Arg(100)->Arg(1000)->Arg(10000);
+
+void EvolutionAlgorithmRunOnceWithStatistics(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = static_cast<std::uint32_t>(state.range(0));
+    parameters.survivors  = parameters.population * 3U / 10U;
+
+    PointAlgorithm algorithm{};
+    algorithm.setParameters(parameters);
+    algorithm.runOnce();
+
+    double best{};
+    algorithm.setStatisticsCallback([&](auto const &statistics) noexcept { best = statistics.maxFitness; });
+    for (auto _ : state)
+    {
+        algorithm.runOnce();
+        benchmark::DoNotOptimize(best);
+    }
+    // compare to EvolutionAlgorithmRunOnce to see the cost of gathering the statistics
+    state.SetItemsProcessed(state.iterations() * (parameters.population - parameters.survivors));
+}
+BENCHMARK(EvolutionAlgorithmRunOnceWithStatistics)->Arg(1000)->Arg(10000);
+
+void EvolutionAlgorithmGeneration(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = static_cast<std::uint32_t>(state.range(0));
+    parameters.survivors  = parameters.population * 3U / 10U;
+
+    NoopAlgorithm algorithm{};
+    algorithm.setParameters(parameters);
+    algorithm.runOnce();
+    for (auto _ : state)
+    {
+        algorithm.runOnce();
+        benchmark::DoNotOptimize(algorithm.generation());
+    }
+    // each generation refills, evaluates and eliminates the losers in one tournament each, without any work in the
+    // individuals this is dominated by the algorithm itself and the time per item stays constant
+    state.SetItemsProcessed(state.iterations() * (parameters.population - parameters.survivors));
+}
+BENCHMARK(EvolutionAlgorithmGeneration)->Arg(1000)->Arg(10000)->Arg(100000);
+
+void EvolutionAlgorithmGenerationLargeGenomes(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = static_cast<std::uint32_t>(state.range(0));
+    parameters.survivors  = parameters.population * 3U / 10U;
+
+    KilobyteAlgorithm algorithm{};
+    algorithm.setParameters(parameters);
+    algorithm.runOnce();
+    for (auto _ : state)
+    {
+        algorithm.runOnce();
+        benchmark::DoNotOptimize(algorithm.generation());
+    }
+    // the genomes are never touched, so this measures how much scanning the population depends on their size
+    state.SetItemsProcessed(state.iterations() * (parameters.population - parameters.survivors));
+}
+BENCHMARK(EvolutionAlgorithmGenerationLargeGenomes)->Arg(10000)->Arg(50000);
+
+void EvolutionAlgorithmParetoGeneration(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = static_cast<std::uint32_t>(state.range(0));
+    parameters.survivors  = parameters.population * 3U / 10U;
+
+    ParetoAlgorithm algorithm{};
+    algorithm.setParameters(parameters);
+    algorithm.runOnce();
+    for (auto _ : state)
+    {
+        algorithm.runOnce();
+        benchmark::DoNotOptimize(algorithm.generation());
+    }
+    // compare to EvolutionAlgorithmGeneration to see the cost of sorting the population into fronts
+    state.SetItemsProcessed(state.iterations() * parameters.population);
+}
+BENCHMARK(EvolutionAlgorithmParetoGeneration)->Arg(1000)->Arg(10000)->Arg(100000);
+
+void EvolutionNonDominatedSort(benchmark::State &state)
+{
+    auto const count = static_cast<size_t>(state.range(0));
+
+    std::minstd_rand                       rng{};
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+    std::vector<std::array<double, 2U>>    objectives(count);
+    for (auto &objective : objectives)
+    {
+        objective = {distribution(rng), distribution(rng)};
+    }
+    std::vector<std::uint32_t>              candidates(count);
+    std::vector<std::uint32_t>              ranks(count);
+    std::vector<std::vector<std::uint32_t>> fronts{};
+    for (auto _ : state)
+    {
+        for (auto i = 0U; i < count; ++i)
+        {
+            candidates[i] = i;
+        }
+        benchmark::DoNotOptimize(Optimisation::Evolution::nonDominatedSort(objectives, candidates, ranks, fronts));
+    }
+    // with two objectives the sort takes O(N log N), so the time per item only grows logarithmically
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(EvolutionNonDominatedSort)->Arg(1000)->Arg(10000)->Arg(100000);
+
+void EvolutionAlgorithmCheckpoint(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = static_cast<std::uint32_t>(state.range(0));
+    parameters.survivors  = parameters.population * 3U / 10U;
+
+    PointAlgorithm algorithm{};
+    algorithm.setParameters(parameters);
+    algorithm.runOnce();
+
+    auto const path = std::filesystem::temp_directory_path() / "thzEvolutionCheckpointBenchmark.bin";
+    for (auto _ : state)
+    {
+        std::ofstream file{path, std::ios::binary};
+        benchmark::DoNotOptimize(algorithm.save(file));
+    }
+    state.SetItemsProcessed(state.iterations() * parameters.population);
+    std::error_code ignored{};
+    std::filesystem::remove(path, ignored);
+}
+// compare to EvolutionAlgorithmRunOnce to see the cost of checkpointing every generation
+BENCHMARK(EvolutionAlgorithmCheckpoint)->Arg(1000)->Arg(10000);
+
+void EvolutionAlgorithmParallelEvaluation(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population        = 1000U;
+    parameters.survivors         = 300U;
+    parameters.evaluationThreads = static_cast<std::uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RolloutAlgorithm algorithm{};
+        algorithm.setParameters(parameters);
+        state.ResumeTiming();
+        algorithm.runOnce();
+        benchmark::DoNotOptimize(algorithm.generation());
+    }
+    state.SetItemsProcessed(state.iterations() * parameters.population);
+}
+// the evaluation threads are not measured by the cpu time of the main thread
+BENCHMARK(EvolutionAlgorithmParallelEvaluation)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+void EvolutionAlgorithmSteadyState(benchmark::State &state)
+{
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population        = 1000U;
+    parameters.survivors         = 300U;
+    parameters.evaluationThreads = static_cast<std::uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RolloutAlgorithm algorithm{};
+        algorithm.setParameters(parameters);
+        state.ResumeTiming();
+        algorithm.runSteadyState(parameters.population);
+        benchmark::DoNotOptimize(algorithm.generation());
+    }
+    state.SetItemsProcessed(state.iterations() * parameters.population);
+}
+BENCHMARK(EvolutionAlgorithmSteadyState)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+} // namespace
+} // namespace Terrahertz::Benchmarks
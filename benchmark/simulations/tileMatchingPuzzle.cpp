@@ -0,0 +1,255 @@
+#include "THzAutoGaming/simulations/basicTileMatchingPuzzle.hpp"
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+
+namespace Terrahertz::Benchmarks {
+namespace {
+
+using Simulations::TileMatchingPuzzle;
+
+/// @brief The number of different tile types used by the benchmarks in this file not taking it as argument.
+constexpr std::uint8_t TypeCount{5U};
+
+/// @brief Swaps the given tile with its right neighbour.
+///
+/// @tparam TPuzzle The type of puzzle.
+/// @param puzzle The puzzle to swap the tiles on.
+/// @param x The row of the left tile.
+/// @param y The column of both tiles.
+template <typename TPuzzle>
+void swapRight(TPuzzle &puzzle, std::uint8_t const x, std::uint8_t const y) noexcept
+{
+    auto const left  = puzzle(x, y);
+    auto const right = puzzle(x + 1U, y);
+    puzzle.setTile(x, y, right);
+    puzzle.setTile(x + 1U, y, left);
+}
+
+/// @brief Returns the next position to swap, walking over the whole grid.
+///
+/// @param x The row of the current position.
+/// @param y The column of the current position.
+/// @param size The size of the grid.
+void nextPosition(std::uint8_t &x, std::uint8_t &y, std::uint8_t const size) noexcept
+{
+    ++x;
+    if ((x + 1U) >= size)
+    {
+        x = 0U;
+        ++y;
+        if (y >= size)
+        {
+            y = 0U;
+        }
+    }
+}
+
+void TileMatchingPuzzleCopy(benchmark::State &state)
+{
+    auto const               size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle const root{size, size, TypeCount};
+    for (auto _ : state)
+    {
+        TileMatchingPuzzle branch{root};
+        benchmark::DoNotOptimize(branch);
+    }
+}
+BENCHMARK(TileMatchingPuzzleCopy)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleRestore(benchmark::State &state)
+{
+    auto const                size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle        puzzle{size, size, TypeCount};
+    TileMatchingPuzzle::State root{};
+    puzzle.snapshot(root);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(puzzle.restore(root));
+    }
+}
+BENCHMARK(TileMatchingPuzzleRestore)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleCopyAndSimulate(benchmark::State &state)
+{
+    auto const               size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle const root{size, size, TypeCount};
+    std::uint8_t             x{};
+    std::uint8_t             y{};
+    for (auto _ : state)
+    {
+        TileMatchingPuzzle branch{root};
+        swapRight(branch, x, y);
+        benchmark::DoNotOptimize(branch.simulate());
+        nextPosition(x, y, size);
+    }
+}
+BENCHMARK(TileMatchingPuzzleCopyAndSimulate)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleRestoreAndSimulate(benchmark::State &state)
+{
+    auto const                size      = static_cast<std::uint8_t>(state.range(0));
+    auto const                typeCount = static_cast<std::uint8_t>(state.range(1));
+    TileMatchingPuzzle        puzzle{size, size, typeCount};
+    TileMatchingPuzzle::State root{};
+    puzzle.snapshot(root);
+    std::uint8_t x{};
+    std::uint8_t y{};
+    for (auto _ : state)
+    {
+        puzzle.restore(root);
+        swapRight(puzzle, x, y);
+        benchmark::DoNotOptimize(puzzle.simulate());
+        nextPosition(x, y, size);
+    }
+}
+BENCHMARK(TileMatchingPuzzleRestoreAndSimulate)
+    ->Args({6, 4})
+    ->Args({8, 4})
+    ->Args({8, 5})
+    ->Args({8, 6})
+    ->Args({12, 5})
+    ->Args({12, 7})
+    ->Args({16, 6});
+
+void TileMatchingPuzzleRestoreAndSimulateIntoBuffer(benchmark::State &state)
+{
+    auto const                                size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle                        puzzle{size, size, TypeCount};
+    TileMatchingPuzzle::State                 root{};
+    std::vector<TileMatchingPuzzle::Collapse> collapses(static_cast<size_t>(size) * size);
+    puzzle.snapshot(root);
+    std::uint8_t x{};
+    std::uint8_t y{};
+    for (auto _ : state)
+    {
+        puzzle.restore(root);
+        swapRight(puzzle, x, y);
+        benchmark::DoNotOptimize(puzzle.simulate(collapses));
+        nextPosition(x, y, size);
+    }
+}
+BENCHMARK(TileMatchingPuzzleRestoreAndSimulateIntoBuffer)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleLegalMoves(benchmark::State &state)
+{
+    auto const                            size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle const              puzzle{size, size, TypeCount};
+    std::vector<TileMatchingPuzzle::Move> moves(2U * size * size);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(puzzle.legalMoves(moves));
+    }
+}
+BENCHMARK(TileMatchingPuzzleLegalMoves)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleLegalMovesBruteForce(benchmark::State &state)
+{
+    auto const                size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle        puzzle{size, size, TypeCount};
+    TileMatchingPuzzle::State root{};
+    puzzle.snapshot(root);
+    for (auto _ : state)
+    {
+        // tries the same horizontal and vertical swaps as legalMoves
+        size_t count{};
+        for (std::uint8_t y{}; y < size; ++y)
+        {
+            for (std::uint8_t x{}; x < size; ++x)
+            {
+                for (auto const vertical : {false, true})
+                {
+                    if (!puzzle.swapTiles({x, y, vertical}))
+                    {
+                        continue;
+                    }
+                    if (!puzzle.simulate(false).empty())
+                    {
+                        ++count;
+                    }
+                    puzzle.restore(root);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(TileMatchingPuzzleLegalMovesBruteForce)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleSwapAndSimulateWithoutRefill(benchmark::State &state)
+{
+    auto const                size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle        puzzle{size, size, TypeCount};
+    TileMatchingPuzzle::State root{};
+    puzzle.snapshot(root);
+    std::uint8_t x{};
+    std::uint8_t y{};
+    for (auto _ : state)
+    {
+        swapRight(puzzle, x, y);
+        benchmark::DoNotOptimize(puzzle.simulate(false));
+        puzzle.restore(root);
+        nextPosition(x, y, size);
+    }
+}
+BENCHMARK(TileMatchingPuzzleSwapAndSimulateWithoutRefill)->Arg(8)->Arg(12);
+
+void TileMatchingPuzzleSwapAndPeekCollapses(benchmark::State &state)
+{
+    auto const         size = static_cast<std::uint8_t>(state.range(0));
+    TileMatchingPuzzle puzzle{size, size, TypeCount};
+    std::uint8_t       x{};
+    std::uint8_t       y{};
+    for (auto _ : state)
+    {
+        swapRight(puzzle, x, y);
+        benchmark::DoNotOptimize(puzzle.peekCollapses());
+        // peeking does not change the grid, so swapping back restores it
+        swapRight(puzzle, x, y);
+        nextPosition(x, y, size);
+    }
+}
+BENCHMARK(TileMatchingPuzzleSwapAndPeekCollapses)->Arg(8)->Arg(12);
+
+template <std::uint8_t TSize>
+void BasicTileMatchingPuzzleCopyAndSimulate(benchmark::State &state)
+{
+    using Puzzle = Simulations::BasicTileMatchingPuzzle<TSize, TSize, TypeCount>;
+    Puzzle const root{};
+    std::uint8_t x{};
+    std::uint8_t y{};
+    for (auto _ : state)
+    {
+        Puzzle branch{root};
+        swapRight(branch, x, y);
+        benchmark::DoNotOptimize(branch.simulate());
+        nextPosition(x, y, TSize);
+    }
+}
+BENCHMARK_TEMPLATE(BasicTileMatchingPuzzleCopyAndSimulate, 8U);
+BENCHMARK_TEMPLATE(BasicTileMatchingPuzzleCopyAndSimulate, 12U);
+
+template <std::uint8_t TSize>
+void BasicTileMatchingPuzzleRestoreAndSimulate(benchmark::State &state)
+{
+    using Puzzle = Simulations::BasicTileMatchingPuzzle<TSize, TSize, TypeCount>;
+    Puzzle                 puzzle{};
+    typename Puzzle::State root{};
+    puzzle.snapshot(root);
+    std::uint8_t x{};
+    std::uint8_t y{};
+    for (auto _ : state)
+    {
+        puzzle.restore(root);
+        swapRight(puzzle, x, y);
+        benchmark::DoNotOptimize(puzzle.simulate());
+        nextPosition(x, y, TSize);
+    }
+}
+BENCHMARK_TEMPLATE(BasicTileMatchingPuzzleRestoreAndSimulate, 8U);
+BENCHMARK_TEMPLATE(BasicTileMatchingPuzzleRestoreAndSimulate, 12U);
+
+} // namespace
+} // namespace Terrahertz::Benchmarks
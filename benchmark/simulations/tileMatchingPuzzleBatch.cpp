@@ -0,0 +1,45 @@
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+#include "THzAutoGaming/simulations/tileMatchingPuzzleBatch.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+namespace Terrahertz::Benchmarks {
+namespace {
+
+using Simulations::TileMatchingPuzzle;
+using Simulations::TileMatchingPuzzleBatch;
+
+/// @brief The number of different tile types used by all benchmarks in this file.
+constexpr std::uint8_t TypeCount{5U};
+
+void TileMatchingPuzzleBatchRestoreAndSimulate(benchmark::State &state)
+{
+    auto const                size       = static_cast<std::uint8_t>(state.range(0));
+    auto const                boardCount = static_cast<std::uint32_t>(state.range(1));
+    TileMatchingPuzzle        puzzle{size, size, TypeCount};
+    TileMatchingPuzzle::State root{};
+    puzzle.snapshot(root);
+    TileMatchingPuzzleBatch batch{size, size, TypeCount, boardCount};
+    std::uint32_t           offset{};
+    for (auto _ : state)
+    {
+        // every board performs a different swap, like the rollouts of different moves would
+        batch.restore(root);
+        for (auto board = 0U; board < boardCount; ++board)
+        {
+            auto const position = (board + offset) % ((size - 1U) * size);
+            batch.rng(board).seed(board + offset);
+            batch.swapTiles(board, {static_cast<std::uint8_t>(position % (size - 1U)),
+                                    static_cast<std::uint8_t>(position / (size - 1U)),
+                                    false});
+        }
+        benchmark::DoNotOptimize(batch.simulate());
+        ++offset;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * boardCount);
+}
+BENCHMARK(TileMatchingPuzzleBatchRestoreAndSimulate)->Args({8, 64})->Args({8, 256})->Args({12, 256});
+
+} // namespace
+} // namespace Terrahertz::Benchmarks
@@ -0,0 +1,46 @@
+#include "THzAutoGaming/utility/xoshiro256.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+
+namespace Terrahertz::Benchmarks {
+namespace {
+
+/// @brief The number of different tile types drawn from.
+constexpr std::uint16_t TypeCount{5U};
+
+void UniformIntDistributionDefaultRandomEngine(benchmark::State &state)
+{
+    std::default_random_engine                   rng{};
+    std::uniform_int_distribution<std::uint16_t> distribution{1U, TypeCount};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(distribution(rng));
+    }
+}
+BENCHMARK(UniformIntDistributionDefaultRandomEngine);
+
+void Xoshiro256Bounded(benchmark::State &state)
+{
+    Xoshiro256 rng{};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(1U + rng.bounded(TypeCount));
+    }
+}
+BENCHMARK(Xoshiro256Bounded);
+
+void Xoshiro256Jump(benchmark::State &state)
+{
+    Xoshiro256 rng{};
+    for (auto _ : state)
+    {
+        rng.jump();
+        benchmark::DoNotOptimize(rng);
+    }
+}
+BENCHMARK(Xoshiro256Jump);
+
+} // namespace
+} // namespace Terrahertz::Benchmarks
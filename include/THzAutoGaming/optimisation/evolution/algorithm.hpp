@@ -1,39 +1,74 @@
 #ifndef THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_ALGORITHM_HPP
 #define THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_ALGORITHM_HPP
 
+#include "THzAutoGaming/optimisation/evolution/pareto.hpp"
+#include "THzAutoGaming/optimisation/evolution/statistics.hpp"
+#include "THzAutoGaming/utility/threadPool.hpp"
+
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <sstream>
+#include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Terrahertz::Optimisation::Evolution {
 
 // clang-format off
 
-/// @brief Concept for an individual of the population for the evolutionary algorithm.
+/// @brief Concept for an individual drawing its random values from the random number generator of the algorithm.
+///
+/// @remarks The algorithm passes the generator of the thread creating the individual, so the individuals differ from
+/// each other and runs are reproduced by seeding the algorithm.
 template<typename TIndividualType>
-concept Individual = requires(TIndividualType individual, TIndividualType const cIndividual, std::ifstream iFile, std::ofstream oFile)
+concept RandomizedIndividual = requires(TIndividualType individual, TIndividualType const cIndividual, std::default_random_engine rng)
 {
-    // copy constructible
-    TIndividualType(cIndividual);
+    // method for initializing the individual with new values from scrath
+    {individual.init(rng)};
 
-    // copy assignable
-    individual = cIndividual;
+    // method for initializing the individual with values from combining two existing individuals
+    {individual.reproduce(cIndividual, cIndividual, rng)};
 
+    // method for initializing the individual with slightly altered values from one existing individual
+    {individual.mutate(cIndividual, rng)};
+};
+
+/// @brief Concept for an individual of the population for the evolutionary algorithm.
+///
+/// @remarks Individuals that can not be copied must be default constructible, as empty slots are filled with default
+/// constructed individuals instead of copies of the root individual. Individuals needing random values should draw
+/// them from the generator passed by the algorithm, see RandomizedIndividual.
+template<typename TIndividualType>
+concept Individual = std::movable<TIndividualType> &&
+                     (std::copyable<TIndividualType> || std::default_initializable<TIndividualType>) &&
+                     (RandomizedIndividual<TIndividualType> ||
+                      requires(TIndividualType individual, TIndividualType const cIndividual)
+{
     // method for initializing the individual with new values from scrath
     {individual.init()};
 
     // method for initializing the individual with values from combining two existing individuals
     {individual.reproduce(cIndividual, cIndividual)};
-    
+
     // method for initializing the individual with slightly altered values from one existing individual
     {individual.mutate(cIndividual)};
-
+}) &&
+                     requires(TIndividualType individual, TIndividualType const cIndividual, std::ifstream iFile, std::ofstream oFile)
+{
     // method for saving the state of the individual to a std::ofstream
     {cIndividual.save(oFile)} -> std::same_as<bool>;
 
@@ -41,7 +76,17 @@ concept Individual = requires(TIndividualType individual, TIndividualType const
     {individual.load(iFile)} -> std::same_as<bool>;
 };
 
+/// @brief Concept for an individual that can be copied, e.g. to send copies to other populations.
+///
+/// @remarks Individuals that are only movable are default constructed instead of copied from the root individual and
+/// reproduce in place, without ever being copied.
+template<typename TIndividualType>
+concept CopyableIndividual = Individual<TIndividualType> && std::copyable<TIndividualType>;
+
 /// @brief Concept for a evaluator for individuals.
+///
+/// @remarks Evaluators return either a single double or a std::array of doubles, the latter selects the survivors by
+/// Pareto dominance of the objectives.
 template<typename TEvaluatorType, typename TIndividualType>
 concept Evaluator = requires(TEvaluatorType evaluator, TEvaluatorType const cEvaluator, TIndividualType const individual)
 {
@@ -51,7 +96,7 @@ concept Evaluator = requires(TEvaluatorType evaluator, TEvaluatorType const cEva
     // copy assignable
     evaluator = cEvaluator;
 
-    {evaluator(individual)} -> std::same_as<double>;
+    {evaluator(individual)} -> Fitness;
 };
 
 // clang-format on
@@ -84,23 +129,68 @@ struct Parameters
     ///
     /// @remark Ratios will change based on how many individuals created each methods have been sorted out.
     double ratioDynamics{0.01};
+
+    /// @brief The number of threads evaluating the population, 0 to use one thread per hardware thread.
+    ///
+    /// @remark With more than one thread each thread evaluates using its own copy of the evaluator.
+    std::uint32_t evaluationThreads{1U};
+
+    /// @brief True to evaluate surviving individuals again in every generation, for evaluators returning noisy results.
+    ///
+    /// @remark The fitness of a resampled individual is the mean of all its evaluations, otherwise individuals are only
+    /// evaluated once after they were filled.
+    bool resampleFitness{false};
+};
+
+/// @brief Structure containing the current ratios of the refill strategies, the ratios sum up to 1.0.
+struct Ratios
+{
+    /// @brief The ratio of empty individuals refilled via reproduction.
+    double reproduction{};
+
+    /// @brief The ratio of empty individuals refilled via mutation.
+    double mutation{};
+
+    /// @brief The ratio of empty individuals refilled via reinitialisation.
+    double reinit{1.0};
 };
 
 /// @brief Tempalte class encapsulating the evolutionary algorithm.
+///
+/// @remarks If the evaluator returns several objectives the survivors are selected like in NSGA-II: by the front of
+/// non-dominated individuals they belong to and, within the last front that fits, by their crowding distance. The
+/// scalar fitness used by the accessors, statistics, migrations and steady-state runs is the first objective then.
+///
+/// An algorithm owns its evaluation threads and the lock they share, so it can neither be copied nor moved. Keep it in
+/// a std::unique_ptr to hand it around, or use save and load to duplicate a run.
 template <Individual TIndividualType, Evaluator<TIndividualType> TEvaluatorType>
 class Algorithm
 {
 public:
+    /// @brief The type of the fitness returned by the evaluator.
+    using FitnessType = std::invoke_result_t<TEvaluatorType &, TIndividualType const &>;
+
+    /// @brief The number of objectives of the fitness.
+    static constexpr size_t Objectives = ObjectiveCount<FitnessType>;
+
+    /// @brief True if the survivors are selected by Pareto dominance, false if they are selected by tournaments.
+    static constexpr bool MultiObjective = !std::same_as<FitnessType, double>;
+
     /// @brief Initializes a new Algorithm instance.
     ///
     /// @param rootIndividual The individual all others will be copied from, used for handing in external information.
     /// @param evaluator The evaluator instance used by the algorithm.
+    /// @remarks If the individuals are not copyable all others are default constructed instead.
     Algorithm(TIndividualType rootIndividual = {}, TEvaluatorType evaluator = {}) noexcept
-        : _rootIndividual{rootIndividual}, _evaluator{evaluator}
+        : _rootIndividual{std::move(rootIndividual)}, _evaluator{evaluator}
     {
         resizePopulation();
+        resetRatios();
     }
 
+    Algorithm(Algorithm const &)            = delete;
+    Algorithm &operator=(Algorithm const &) = delete;
+
     /// @brief Returns the parameters of the algorithm.
     ///
     /// @return The current parameters of the algorithm.
@@ -136,64 +226,264 @@ public:
         {
             return false;
         }
-        _parameters = newParameters;
+        auto const threadsChanged = newParameters.evaluationThreads != _parameters.evaluationThreads;
+        _parameters               = newParameters;
         resizePopulation();
+        resetRatios();
+        if (threadsChanged)
+        {
+            createWorkers();
+        }
         return true;
     }
 
-    bool load(std::ifstream &file) noexcept { return false; }
+    /// @brief Loads a checkpoint written by save, replacing the parameters, generation and population.
+    ///
+    /// @param file The file to read from, opened in binary mode.
+    /// @return True if the checkpoint was loaded, false otherwise.
+    /// @remarks Nothing is changed if the header or the parameters of the checkpoint are invalid. If reading the
+    /// population fails afterwards, the population is left empty and the generation is reset to 0.
+    ///
+    /// The number of evaluation threads is kept, as it depends on the machine instead of the run. The random number
+    /// generators of the threads are restored if the checkpoint was saved using as many threads, otherwise they are
+    /// seeded from the restored seed. These generators are only used by steady-state runs using several threads,
+    /// which also depend on the scheduling of the threads and therefore never resume exactly.
+    bool load(std::ifstream &file) noexcept
+    {
+        std::uint32_t magic{};
+        std::uint32_t version{};
+        std::uint32_t objectives{};
+        if (!readValue(file, magic) || !readValue(file, version) || (magic != CheckpointMagic) ||
+            (version != CheckpointVersion) || !readValue(file, objectives) || (objectives != Objectives))
+        {
+            return false;
+        }
 
-    bool save(std::ofstream &file) noexcept { return false; }
+        Parameters                              parameters{};
+        std::uint8_t                            resample{};
+        std::uint64_t                           generation{};
+        Ratios                                  ratios{};
+        std::uint32_t                           seed{};
+        std::default_random_engine              rng{};
+        std::uint32_t                           workerCount{};
+        std::vector<std::default_random_engine> workerRngs{};
+        bool success = readValue(file, parameters.population) && readValue(file, parameters.survivors) &&
+                       readValue(file, parameters.reproductionPortion) && readValue(file, parameters.mutationPortion) &&
+                       readValue(file, parameters.reinitPortion) && readValue(file, parameters.ratioDynamics) &&
+                       readValue(file, resample) && readValue(file, generation) &&
+                       readValue(file, ratios.reproduction) && readValue(file, ratios.mutation) &&
+                       readValue(file, ratios.reinit) && readValue(file, seed) && readRng(file, rng) &&
+                       readValue(file, workerCount);
+        for (auto t = 0U; success && (t < workerCount); ++t)
+        {
+            success = readRng(file, workerRngs.emplace_back());
+        }
+        parameters.resampleFitness   = resample != 0U;
+        parameters.evaluationThreads = _parameters.evaluationThreads;
+        if (!success || !setParameters(parameters))
+        {
+            return false;
+        }
+        _generation = generation;
+        _ratios     = ratios;
+        _seed       = seed;
+        _rng        = rng;
+        for (auto t = 0U; _pool && (t < _pool->threadCount()); ++t)
+        {
+            if (workerRngs.size() == _pool->threadCount())
+            {
+                _workers[t].rng = workerRngs[t];
+            }
+            else
+            {
+                _workers[t].rng.seed(_seed + t + 1U);
+            }
+        }
 
-    /// @brief Runs the evolution for one generation.
-    void runOnce() noexcept
-    {
-        for (auto &i : _population)
+        // individuals are read one by one straight into the population
+        clearPopulation();
+        for (auto i = 0U; i < _states.size(); ++i)
         {
-            if (i.state == Individual::State::Empty)
+            std::uint8_t state{};
+            success = readValue(file, state) && (state <= static_cast<std::uint8_t>(State::Mutation)) &&
+                      readValue(file, _evaluations[i]) && readValue(file, _fitness[i]);
+            if constexpr (MultiObjective)
+            {
+                success = success && readValue(file, _objectives[i]);
+            }
+            if (success && (state != static_cast<std::uint8_t>(State::Empty)))
             {
-                fillIndividual(i);
+                success = _individuals[i].load(file);
+            }
+            if (!success)
+            {
+                clearPopulation();
+                _generation = 0U;
+                resetRatios();
+                return false;
             }
-            i.fitness = _evaluator(i.individual);
+            _states[i] = static_cast<State>(state);
         }
+        return true;
+    }
+
+    /// @brief Saves a checkpoint of the parameters, generation, random number generators and population.
+    ///
+    /// @param file The file to write to, opened in binary mode.
+    /// @return True if the checkpoint was written, false otherwise.
+    /// @remarks The checkpoint is written in the native byte order. Individuals are written one by one using their save
+    /// method, so the population is never buffered.
+    bool save(std::ofstream &file) const noexcept
+    {
+        auto const workerCount = _pool ? _pool->threadCount() : 0U;
 
-        std::uniform_int_distribution<size_t> dist{0U, _population.size() - 1U};
-        for (auto i = _parameters.population - _parameters.survivors; i > 0; --i)
+        auto success = writeValue(file, CheckpointMagic) && writeValue(file, CheckpointVersion) &&
+                       writeValue(file, static_cast<std::uint32_t>(Objectives)) &&
+                       writeValue(file, _parameters.population) && writeValue(file, _parameters.survivors) &&
+                       writeValue(file, _parameters.reproductionPortion) &&
+                       writeValue(file, _parameters.mutationPortion) && writeValue(file, _parameters.reinitPortion) &&
+                       writeValue(file, _parameters.ratioDynamics) &&
+                       writeValue(file, static_cast<std::uint8_t>(_parameters.resampleFitness)) &&
+                       writeValue(file, static_cast<std::uint64_t>(_generation)) &&
+                       writeValue(file, _ratios.reproduction) && writeValue(file, _ratios.mutation) &&
+                       writeValue(file, _ratios.reinit) && writeValue(file, _seed) && writeRng(file, _rng) &&
+                       writeValue(file, workerCount);
+        for (auto t = 0U; success && (t < workerCount); ++t)
+        {
+            success = writeRng(file, _workers[t].rng);
+        }
+        for (auto i = 0U; i < _states.size(); ++i)
         {
-            auto idxA = dist(_rng);
-            while (_population[idxA].state == Individual::State::Empty)
+            if (!success)
             {
-                ++idxA;
-                if (idxA == _population.size())
-                {
-                    idxA = 0U;
-                }
+                return false;
             }
-            auto idxB = dist(_rng);
-            while ((_population[idxB].state == Individual::State::Empty) || (idxA == idxB))
+            success = writeValue(file, static_cast<std::uint8_t>(_states[i])) && writeValue(file, _evaluations[i]) &&
+                      writeValue(file, _fitness[i]);
+            if constexpr (MultiObjective)
             {
-                ++idxB;
-                if (idxB == _population.size())
-                {
-                    idxB = 0U;
-                }
+                success = success && writeValue(file, _objectives[i]);
             }
-            if (_population[idxA].fitness > _population[idxB].fitness)
+            if (success && (_states[i] != State::Empty))
             {
-                _population[idxB].state = Individual::State::Empty;
+                success = _individuals[i].save(file);
             }
-            else
+        }
+        return success;
+    }
+
+    /// @brief Runs the evolution for one generation.
+    ///
+    /// @remarks Refills the empty individuals, evaluates the population and removes the losers of tournaments until
+    /// only the survivors are left.
+    void runOnce() noexcept
+    {
+        refill();
+
+        // statistics are only gathered if somebody listens, so runs without a callback do not pay for them
+        Statistics                            statistics{};
+        std::chrono::steady_clock::time_point start{};
+        if (_statisticsCallback)
+        {
+            auto const unevaluated = std::count(_evaluations.begin(), _evaluations.end(), 0U);
+            statistics.evaluations = _parameters.resampleFitness ? _states.size() : static_cast<size_t>(unevaluated);
+            start                  = std::chrono::steady_clock::now();
+        }
+        evaluatePopulation();
+        if (_statisticsCallback)
+        {
+            std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+            statistics.evaluationSeconds = elapsed.count();
+            summarizeGeneration(statistics);
+        }
+
+        std::array<size_t, 4U> freshSurvivors{};
+        collectIndices();
+        if constexpr (MultiObjective)
+        {
+            selectParetoSurvivors();
+        }
+        else
+        {
+            // the individuals alive after the refill compete, losers are swap-removed from the index array so every
+            // tournament is O(1) and draws uniformly from the individuals still alive
+            while (_alive.size() > _parameters.survivors)
             {
-                _population[idxA].state = Individual::State::Empty;
+                auto const [idxA, idxB] = randomAlivePair(_rng);
+                auto const loser       = (_fitness[_alive[idxA]] > _fitness[_alive[idxB]]) ? idxB : idxA;
+                _states[_alive[loser]] = State::Empty;
+                _alive[loser]          = _alive.back();
+                _alive.pop_back();
             }
         }
+        for (auto const index : _alive)
+        {
+            if (_fresh[index] != 0U)
+            {
+                ++freshSurvivors[static_cast<size_t>(_states[index])];
+            }
+        }
+        std::fill(_fresh.begin(), _fresh.end(), std::uint8_t{});
+        if (_generation != 0U)
+        {
+            updateRatios(freshSurvivors);
+        }
+        if (_statisticsCallback)
+        {
+            statistics.initSurvivors         = freshSurvivors[static_cast<size_t>(State::Init)];
+            statistics.reproductionSurvivors = freshSurvivors[static_cast<size_t>(State::Reproduction)];
+            statistics.mutationSurvivors     = freshSurvivors[static_cast<size_t>(State::Mutation)];
+            _statisticsCallback(statistics);
+        }
         ++_generation;
     }
 
+    /// @brief Sets the callback receiving the statistics at the end of every generation run by runOnce.
+    ///
+    /// @param callback The callback, e.g. a StatisticsWriter, or an empty function to stop gathering statistics.
+    void setStatisticsCallback(std::function<void(Statistics const &)> callback) noexcept
+    {
+        _statisticsCallback = std::move(callback);
+    }
+
+    /// @brief Runs the evolution in steady-state mode until the given number of children have been inserted.
+    ///
+    /// @param children The number of children to create.
+    /// @remarks Instead of running generations each thread repeatedly creates a child using reproduction, mutation or
+    /// reinitialisation according to the portions of the parameters, evaluates it and inserts it into an empty slot or
+    /// in place of the loser of a tournament. There is no barrier between the children, so threads never wait for the
+    /// slow evaluations of others. The population is only locked while parents are copied and the child is inserted.
+    /// With several objectives the dominated contestant loses the tournament, the first objective breaks ties.
+    void runSteadyState(size_t const children) noexcept
+    {
+        collectIndices();
+
+        SteadyState steadyState{children};
+        if (!_pool)
+        {
+            steadyStateWorker(steadyState, _evaluator, _rng);
+            return;
+        }
+        _pool->run([&](std::uint32_t const index) noexcept {
+            steadyStateWorker(steadyState, *_workers[index].evaluator, _workers[index].rng);
+        });
+    }
+
+    /// @brief Runs generations until the given predicate is satisfied.
+    ///
+    /// @tparam TFunctor The type of the predicate.
+    /// @param predicate Called with the algorithm before each generation, returns true to stop the evolution.
+    /// @return The number of generations run.
     template <typename TFunctor>
     size_t runUntil(TFunctor const &predicate) noexcept
     {
-        return 0U;
+        size_t generations{};
+        while (!predicate(static_cast<Algorithm const &>(*this)))
+        {
+            runOnce();
+            ++generations;
+        }
+        return generations;
     }
 
     /// @brief Returns the current generation of the evolution.
@@ -201,74 +491,922 @@ public:
     /// @return The current generation of the evolution.
     size_t generation() const noexcept { return _generation; }
 
-    TIndividualType const &bestIndividual() const noexcept {}
+    /// @brief Returns the current ratios of the refill strategies.
+    ///
+    /// @return The current ratios of the refill strategies.
+    Ratios const &ratios() const noexcept { return _ratios; }
 
-private:
-    /// @brief Structure to augment the TIndividualType with additional data.
-    struct Individual
+    /// @brief Returns the evaluated individual with the highest fitness.
+    ///
+    /// @return The best individual, the root individual if none was evaluated yet.
+    TIndividualType const &bestIndividual() const noexcept
+    {
+        auto const best = bestIndex();
+        return (best < _states.size()) ? _individuals[best] : _rootIndividual;
+    }
+
+    /// @brief Returns the fitness of the evaluated individual with the highest fitness.
+    ///
+    /// @return The highest fitness, the lowest double if no individual was evaluated yet.
+    double bestFitness() const noexcept
+    {
+        auto const best = bestIndex();
+        return (best < _states.size()) ? _fitness[best] : std::numeric_limits<double>::lowest();
+    }
+
+    /// @brief Seeds the random number generators of the algorithm.
+    ///
+    /// @param value The seed, algorithms evolving in parallel should use different seeds.
+    void seed(std::uint32_t const value) noexcept
     {
-        /// @brief Enumeration of the state of an individual.
-        enum class State
+        _seed = value;
+        _rng.seed(value);
+        for (auto t = 0U; _pool && (t < _pool->threadCount()); ++t)
         {
-            // Individual is empty
-            Empty,
+            _workers[t].rng.seed(_seed + t + 1U);
+        }
+    }
 
-            // Individual was created by calling init
-            Init,
+    /// @brief Copies the evaluated individuals with the highest fitness.
+    ///
+    /// @param count The maximum number of individuals to copy.
+    /// @param individuals Receives the copied individuals, ordered from best to worst.
+    /// @param fitness Receives the fitness of the copied individuals.
+    void bestIndividuals(size_t const                  count,
+                         std::vector<TIndividualType> &individuals,
+                         std::vector<double>          &fitness) const noexcept
+        requires std::copyable<TIndividualType>
+    {
+        individuals.clear();
+        fitness.clear();
+        for (auto const index : topIndices(count))
+        {
+            individuals.push_back(_individuals[index]);
+            fitness.push_back(_fitness[index]);
+        }
+    }
 
-            // Individual was created by calling reproduce
-            Reproduction,
+    /// @brief Copies the evaluated individuals not dominated by any other evaluated individual.
+    ///
+    /// @param individuals Receives the copied individuals.
+    /// @param objectives Receives the objectives of the copied individuals.
+    void paretoFront(std::vector<TIndividualType> &individuals, std::vector<FitnessType> &objectives) const noexcept
+        requires MultiObjective && std::copyable<TIndividualType>
+    {
+        individuals.clear();
+        objectives.clear();
+        std::vector<std::uint32_t> candidates{};
+        for (auto i = 0U; i < _states.size(); ++i)
+        {
+            if ((_states[i] != State::Empty) && (_evaluations[i] != 0U))
+            {
+                candidates.push_back(i);
+            }
+        }
+        std::vector<std::uint32_t>              ranks(_states.size());
+        std::vector<std::vector<std::uint32_t>> fronts{};
+        if (nonDominatedSort(_objectives, candidates, ranks, fronts) == 0U)
+        {
+            return;
+        }
+        for (auto const index : fronts[0U])
+        {
+            individuals.push_back(_individuals[index]);
+            objectives.push_back(_objectives[index]);
+        }
+    }
 
-            // Individual was created by calling mutate
-            Mutation
-        };
+    /// @brief Inserts an individual evaluated elsewhere, e.g. a migrant of another population.
+    ///
+    /// @param individual The individual to insert.
+    /// @param fitness The fitness of the individual, only evaluated again with resampling or several objectives.
+    /// @remarks The individual is placed in an empty slot, or replaces the individual with the lowest fitness if the
+    /// population is full. It competes in the tournaments of the next generation.
+    void insert(TIndividualType const &individual, double const fitness) noexcept
+        requires std::copyable<TIndividualType>
+    {
+        _individuals[insertSlot(fitness)] = individual;
+    }
+
+    /// @brief Inserts an individual evaluated elsewhere, e.g. a migrant of another population.
+    ///
+    /// @param individual The individual to move into the population.
+    /// @param fitness The fitness of the individual, only evaluated again with resampling or several objectives.
+    /// @remarks The individual is placed in an empty slot, or replaces the individual with the lowest fitness if the
+    /// population is full. It competes in the tournaments of the next generation.
+    void insert(TIndividualType &&individual, double const fitness) noexcept
+    {
+        _individuals[insertSlot(fitness)] = std::move(individual);
+    }
 
-        /// @brief The state of the individual.
-        State state{};
+    /// @brief Writes the evaluated individuals with the highest fitness to a file, so another process can insert them.
+    ///
+    /// @param file The file to write to, opened in binary mode.
+    /// @param count The maximum number of individuals to write.
+    /// @return True if the individuals were written, false otherwise.
+    bool emigrate(std::ofstream &file, size_t const count) const noexcept
+    {
+        auto const indices = topIndices(count);
+        auto       success = writeValue(file, MigrationMagic) &&
+                       writeValue(file, static_cast<std::uint32_t>(indices.size()));
+        for (auto i = 0U; success && (i < indices.size()); ++i)
+        {
+            success = writeValue(file, _fitness[indices[i]]) && _individuals[indices[i]].save(file);
+        }
+        return success;
+    }
 
-        /// @brief The fitness of the individual.
-        double fitness{};
+    /// @brief Reads individuals written by emigrate and inserts them.
+    ///
+    /// @param file The file to read from, opened in binary mode.
+    /// @return True if all individuals were read, false otherwise.
+    /// @remarks Individuals read before an error occurred stay inserted. Each individual is loaded straight into the
+    /// slot it is inserted into, the slot is left empty if loading fails.
+    bool immigrate(std::ifstream &file) noexcept
+    {
+        std::uint32_t magic{};
+        std::uint32_t count{};
+        if (!readValue(file, magic) || (magic != MigrationMagic) || !readValue(file, count))
+        {
+            return false;
+        }
+        for (auto i = 0U; i < count; ++i)
+        {
+            double fitness{};
+            if (!readValue(file, fitness))
+            {
+                return false;
+            }
+            auto const slot = insertSlot(fitness);
+            if (!_individuals[slot].load(file))
+            {
+                _states[slot] = State::Empty;
+                return false;
+            }
+        }
+        return true;
+    }
 
-        /// @brief The individual to augment.
-        TIndividualType individual{};
+private:
+    /// @brief The first bytes of every checkpoint.
+    static constexpr std::uint32_t CheckpointMagic{0x4F56'4554U};
+
+    /// @brief The first bytes of every file written by emigrate.
+    static constexpr std::uint32_t MigrationMagic{0x4749'4D54U};
+
+    /// @brief The version of the checkpoint format, increased on every change of the format.
+    static constexpr std::uint32_t CheckpointVersion{3U};
+
+    /// @brief The maximum size of the serialized random number generator accepted when loading.
+    static constexpr std::uint32_t MaxRngStateSize{1U << 16U};
 
-        /// @brief Initializes a new Individual using the given root.
-        ///
-        /// @param root The root individual to copy from.
-        Individual(TIndividualType const &root) noexcept : individual{root} {}
+    /// @brief Writes the bytes of the given value to the file.
+    ///
+    /// @tparam TValue The type of the value.
+    /// @param file The file to write to.
+    /// @param value The value to write.
+    /// @return True if the value was written, false otherwise.
+    template <typename TValue>
+    static bool writeValue(std::ofstream &file, TValue const &value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<TValue>);
+        return static_cast<bool>(file.write(reinterpret_cast<char const *>(&value), sizeof(TValue)));
+    }
+
+    /// @brief Reads the bytes of the given value from the file.
+    ///
+    /// @tparam TValue The type of the value.
+    /// @param file The file to read from.
+    /// @param value The value to read.
+    /// @return True if the value was read, false otherwise.
+    template <typename TValue>
+    static bool readValue(std::ifstream &file, TValue &value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<TValue>);
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(TValue)));
+    }
+
+    /// @brief Writes the state of the given random number generator to the file.
+    ///
+    /// @param file The file to write to.
+    /// @param rng The random number generator to write.
+    /// @return True if the state was written, false otherwise.
+    static bool writeRng(std::ofstream &file, std::default_random_engine const &rng) noexcept
+    {
+        std::ostringstream stream{};
+        stream << rng;
+        auto const state = stream.str();
+        return writeValue(file, static_cast<std::uint32_t>(state.size())) &&
+               file.write(state.data(), static_cast<std::streamsize>(state.size()));
+    }
+
+    /// @brief Reads the state of the given random number generator from the file.
+    ///
+    /// @param file The file to read from.
+    /// @param rng The random number generator to restore.
+    /// @return True if the state was read, false otherwise.
+    static bool readRng(std::ifstream &file, std::default_random_engine &rng) noexcept
+    {
+        std::uint32_t size{};
+        if (!readValue(file, size) || (size > MaxRngStateSize))
+        {
+            return false;
+        }
+        std::string state(size, '\0');
+        if (!file.read(state.data(), size))
+        {
+            return false;
+        }
+        std::istringstream stream{state};
+        return static_cast<bool>(stream >> rng);
+    }
+
+    /// @brief Enumeration of the state of an individual.
+    enum class State : std::uint8_t
+    {
+        // Individual is empty
+        Empty,
+
+        // Individual was created by calling init
+        Init,
+
+        // Individual was created by calling reproduce
+        Reproduction,
+
+        // Individual was created by calling mutate
+        Mutation
     };
 
     /// @brief Resizes the population, keeping all current individual in case it is shrinking.
     void resizePopulation() noexcept
     {
-        if (_population.size() < _parameters.population)
+        auto const population = static_cast<size_t>(_parameters.population);
+        if (_states.size() < population)
         {
-            _population.reserve(_parameters.population);
+            if constexpr (std::copyable<TIndividualType>)
+            {
+                _individuals.resize(population, _rootIndividual);
+            }
+            else
+            {
+                _individuals.resize(population);
+            }
+            _states.resize(population, State::Empty);
+            _fitness.resize(population);
+            _evaluations.resize(population);
+            _fresh.resize(population);
+            if constexpr (MultiObjective)
+            {
+                _objectives.resize(population);
+            }
+            return;
         }
 
-        while (_population.size() < _parameters.population)
+        // individuals alive are moved to the front, only empty ones are removed
+        size_t kept{};
+        for (auto i = 0U; i < _states.size(); ++i)
+        {
+            if (_states[i] == State::Empty)
+            {
+                continue;
+            }
+            if (kept != i)
+            {
+                std::swap(_individuals[kept], _individuals[i]);
+                _states[kept]      = _states[i];
+                _fitness[kept]     = _fitness[i];
+                _evaluations[kept] = _evaluations[i];
+                _fresh[kept]       = _fresh[i];
+                _states[i]         = State::Empty;
+                if constexpr (MultiObjective)
+                {
+                    _objectives[kept] = _objectives[i];
+                }
+            }
+            ++kept;
+        }
+        auto const size = std::max(kept, population);
+        _individuals.erase(_individuals.begin() + size, _individuals.end());
+        _states.resize(size);
+        _fitness.resize(size);
+        _evaluations.resize(size);
+        _fresh.resize(size);
+        if constexpr (MultiObjective)
         {
-            _population.emplace_back(_rootIndividual);
+            _objectives.resize(size);
         }
+    }
 
-        if (_population.size() > _parameters.population)
+    /// @brief Creates a new individual for an empty slot of the population.
+    ///
+    /// @return A copy of the root individual, or a default constructed individual if it can not be copied.
+    TIndividualType makeIndividual() const noexcept
+    {
+        if constexpr (std::copyable<TIndividualType>)
+        {
+            return _rootIndividual;
+        }
+        else
         {
-            _population.erase(
-                std::remove_if(_population.begin(), _population.end(), [](Individual const &i) noexcept -> bool {
-                    return i.state == Individual::State::Empty;
-                }));
+            return TIndividualType{};
         }
     }
 
-    void fillIndividual(Individual &indivual) noexcept
+    /// @brief Empties every individual of the population, sized as given by the parameters.
+    void clearPopulation() noexcept
     {
-        if (_generation == 0U)
+        _states.assign(_parameters.population, State::Empty);
+        _fitness.assign(_parameters.population, 0.0);
+        _evaluations.assign(_parameters.population, 0U);
+        _fresh.assign(_parameters.population, 0U);
+        if constexpr (MultiObjective)
         {
-            indivual.state = Individual::State::Init;
-            indivual.individual.init();
+            _objectives.assign(_parameters.population, FitnessType{});
         }
+        resizePopulation();
+    }
+
+    /// @brief Structure containing the data owned by a single evaluation thread.
+    struct alignas(64) Worker
+    {
+        /// @brief The copy of the evaluator used by the thread, evaluators need not be default constructible.
+        std::optional<TEvaluatorType> evaluator{};
+
+        /// @brief The index of the next individual of the range of the thread to evaluate.
+        std::atomic<size_t> next{};
+
+        /// @brief The end of the range of the thread.
+        size_t end{};
+
+        /// @brief The random number generator used by the thread during steady-state runs.
+        std::default_random_engine rng{};
     };
 
+    /// @brief Structure containing the progress of a steady-state run shared by all threads.
+    struct SteadyState
+    {
+        /// @brief The number of children to create.
+        size_t children{};
+
+        /// @brief The number of children claimed by the threads so far.
+        std::atomic<size_t> claimed{};
+    };
+
+    /// @brief Creates the threads and evaluator copies used for evaluating the population in parallel.
+    void createWorkers() noexcept
+    {
+        _workers.reset();
+        _pool.reset();
+        if (_parameters.evaluationThreads == 1U)
+        {
+            return;
+        }
+        _pool    = std::make_unique<ThreadPool>(_parameters.evaluationThreads);
+        _workers = std::make_unique<Worker[]>(_pool->threadCount());
+        for (auto t = 0U; t < _pool->threadCount(); ++t)
+        {
+            _workers[t].evaluator.emplace(_evaluator);
+            _workers[t].rng.seed(_seed + t + 1U);
+        }
+    }
+
+    /// @brief Determines the fitness of every individual of the population.
+    void evaluatePopulation() noexcept
+    {
+        if (!_pool)
+        {
+            for (auto i = 0U; i < _states.size(); ++i)
+            {
+                evaluateIndividual(i, _evaluator);
+            }
+            return;
+        }
+
+        // each thread starts with its own share of the population and steals from the others when it is done, this
+        // balances uneven evaluation times without a central queue
+        auto const threads = _pool->threadCount();
+        auto const size    = _states.size();
+        for (auto t = 0U; t < threads; ++t)
+        {
+            _workers[t].next = (size * t) / threads;
+            _workers[t].end  = (size * (t + 1U)) / threads;
+        }
+        _pool->run([&](std::uint32_t const index) noexcept {
+            auto &evaluator = *_workers[index].evaluator;
+            for (auto offset = 0U; offset < threads; ++offset)
+            {
+                auto &range = _workers[(index + offset) % threads];
+                for (auto i = range.next.fetch_add(1U); i < range.end; i = range.next.fetch_add(1U))
+                {
+                    evaluateIndividual(i, evaluator);
+                }
+            }
+        });
+    }
+
+    /// @brief Determines the fitness of the given individual unless it is still valid.
+    ///
+    /// @param index The index of the individual to evaluate.
+    /// @param evaluator The evaluator to use.
+    void evaluateIndividual(size_t const index, TEvaluatorType &evaluator) noexcept
+    {
+        if ((_states[index] == State::Empty) || ((_evaluations[index] != 0U) && !_parameters.resampleFitness))
+        {
+            return;
+        }
+        auto const fitness = evaluator(_individuals[index]);
+        ++_evaluations[index];
+        // for the first evaluation this replaces the fitness, afterwards it updates the mean of all evaluations
+        if constexpr (MultiObjective)
+        {
+            auto &objectives = _objectives[index];
+            for (auto m = 0U; m < Objectives; ++m)
+            {
+                objectives[m] += (fitness[m] - objectives[m]) / _evaluations[index];
+            }
+            _fitness[index] = objectives[0U];
+        }
+        else
+        {
+            _fitness[index] += (fitness - _fitness[index]) / _evaluations[index];
+        }
+    }
+
+    /// @brief Sets the fitness of the given individual.
+    ///
+    /// @param index The index of the individual.
+    /// @param fitness The fitness returned by the evaluator.
+    void setFitness(size_t const index, FitnessType const &fitness) noexcept
+    {
+        if constexpr (MultiObjective)
+        {
+            _objectives[index] = fitness;
+            _fitness[index]    = fitness[0U];
+        }
+        else
+        {
+            _fitness[index] = fitness;
+        }
+    }
+
+    /// @brief Checks if the first individual wins a tournament against the second one.
+    ///
+    /// @param indexA The index of the first individual.
+    /// @param indexB The index of the second individual.
+    /// @return True if the first individual is better, false otherwise.
+    bool better(size_t const indexA, size_t const indexB) const noexcept
+    {
+        if constexpr (MultiObjective)
+        {
+            if (dominates(_objectives[indexA], _objectives[indexB]))
+            {
+                return true;
+            }
+            if (dominates(_objectives[indexB], _objectives[indexA]))
+            {
+                return false;
+            }
+        }
+        return _fitness[indexA] > _fitness[indexB];
+    }
+
+    /// @brief Reduces the individuals alive to the survivors with the lowest rank and the highest crowding distance.
+    ///
+    /// @remarks Only the front crossing the number of survivors needs crowding distances, the fronts before it survive
+    /// and the ones after it are eliminated as a whole.
+    void selectParetoSurvivors() noexcept
+    {
+        if (_alive.size() <= _parameters.survivors)
+        {
+            return;
+        }
+        _ranks.resize(_states.size());
+        _crowding.resize(_states.size());
+        auto const fronts = nonDominatedSort(_objectives, _alive, _ranks, _fronts);
+
+        _alive.clear();
+        for (auto f = 0U; f < fronts; ++f)
+        {
+            auto      &front     = _fronts[f];
+            auto const remaining = _parameters.survivors - _alive.size();
+            if (front.size() > remaining)
+            {
+                if (remaining != 0U)
+                {
+                    crowdingDistance(_objectives, front, _crowding);
+                    auto const wider = [&](std::uint32_t const a, std::uint32_t const b) noexcept {
+                        return _crowding[a] > _crowding[b];
+                    };
+                    std::nth_element(front.begin(), front.begin() + (remaining - 1U), front.end(), wider);
+                }
+                for (auto i = remaining; i < front.size(); ++i)
+                {
+                    _states[front[i]] = State::Empty;
+                }
+                front.resize(remaining);
+            }
+            _alive.insert(_alive.end(), front.begin(), front.end());
+        }
+    }
+
+    /// @brief Returns a uniformly drawn position in the index array of the individuals alive.
+    ///
+    /// @param rng The random number generator to use.
+    /// @return The position in _alive.
+    /// @remarks At least one individual must be alive.
+    size_t randomAlive(std::default_random_engine &rng) const noexcept
+    {
+        std::uniform_int_distribution<size_t> dist{0U, _alive.size() - 1U};
+        return dist(rng);
+    }
+
+    /// @brief Returns two distinct uniformly drawn positions in the index array of the individuals alive.
+    ///
+    /// @param rng The random number generator to use.
+    /// @return The positions in _alive.
+    /// @remarks At least two individuals must be alive.
+    std::pair<size_t, size_t> randomAlivePair(std::default_random_engine &rng) const noexcept
+    {
+        auto const first = randomAlive(rng);
+
+        // the second position is drawn from the remaining ones, skipping over the first
+        std::uniform_int_distribution<size_t> dist{0U, _alive.size() - 2U};
+        auto                                  second = dist(rng);
+        if (second >= first)
+        {
+            ++second;
+        }
+        return {first, second};
+    }
+
+    /// @brief Creates, evaluates and inserts children until the steady-state run is completed.
+    ///
+    /// @param steadyState The progress of the steady-state run.
+    /// @param evaluator The evaluator used by the thread.
+    /// @param rng The random number generator used by the thread.
+    void steadyStateWorker(SteadyState                &steadyState,
+                           TEvaluatorType             &evaluator,
+                           std::default_random_engine &rng) noexcept
+    {
+        // copyable individuals are created from copies of their parents outside of the lock, so threads only block each
+        // other while copying, individuals that can not be copied are created from their parents under the lock
+        constexpr auto copyParents = std::copyable<TIndividualType>;
+
+        TIndividualType                child{makeIndividual()};
+        std::optional<TIndividualType> parentA{};
+        std::optional<TIndividualType> parentB{};
+
+        auto const reproduction = _ratios.reproduction;
+        auto const mutation     = reproduction + _ratios.mutation;
+
+        std::uniform_real_distribution<double> method{0.0, 1.0};
+        while (steadyState.claimed.fetch_add(1U) < steadyState.children)
+        {
+            auto state = State::Init;
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+
+                auto const roll = method(rng);
+                if ((_alive.size() >= 2U) && (roll < reproduction))
+                {
+                    auto const [indexA, indexB] = randomAlivePair(rng);
+                    state                       = State::Reproduction;
+                    if constexpr (copyParents)
+                    {
+                        parentA = _individuals[_alive[indexA]];
+                        parentB = _individuals[_alive[indexB]];
+                    }
+                    else
+                    {
+                        reproduce(child, _individuals[_alive[indexA]], _individuals[_alive[indexB]], rng);
+                    }
+                }
+                else if ((_alive.size() >= 1U) && (roll < mutation))
+                {
+                    state = State::Mutation;
+                    if constexpr (copyParents)
+                    {
+                        parentA = _individuals[_alive[randomAlive(rng)]];
+                    }
+                    else
+                    {
+                        mutate(child, _individuals[_alive[randomAlive(rng)]], rng);
+                    }
+                }
+            }
+
+            if ((state == State::Reproduction) && copyParents)
+            {
+                reproduce(child, *parentA, *parentB, rng);
+            }
+            else if ((state == State::Mutation) && copyParents)
+            {
+                mutate(child, *parentA, rng);
+            }
+            else if (state == State::Init)
+            {
+                init(child, rng);
+            }
+            auto const fitness = evaluator(child);
+
+            std::lock_guard<std::mutex> lock{_mutex};
+
+            size_t target{};
+            if (!_empty.empty())
+            {
+                target = _empty.back();
+                _empty.pop_back();
+                _alive.push_back(static_cast<std::uint32_t>(target));
+            }
+            else
+            {
+                // the population is larger than the survivors, so at least two individuals are alive
+                auto const [indexA, indexB] = randomAlivePair(rng);
+
+                target = better(_alive[indexA], _alive[indexB]) ? _alive[indexB] : _alive[indexA];
+            }
+            _states[target]      = state;
+            _evaluations[target] = 1U;
+            setFitness(target, fitness);
+            // the replaced individual becomes the buffer of the next child
+            std::swap(_individuals[target], child);
+        }
+    }
+
+    /// @brief Initializes the given individual with new values from scratch.
+    ///
+    /// @param individual The individual to initialize.
+    /// @param rng The random number generator passed to randomized individuals.
+    static void init(TIndividualType &individual, std::default_random_engine &rng) noexcept
+    {
+        if constexpr (RandomizedIndividual<TIndividualType>)
+        {
+            individual.init(rng);
+        }
+        else
+        {
+            individual.init();
+        }
+    }
+
+    /// @brief Initializes the given individual by combining two existing individuals.
+    ///
+    /// @param individual The individual to initialize.
+    /// @param parentA The first parent.
+    /// @param parentB The second parent.
+    /// @param rng The random number generator passed to randomized individuals.
+    static void reproduce(TIndividualType            &individual,
+                          TIndividualType const      &parentA,
+                          TIndividualType const      &parentB,
+                          std::default_random_engine &rng) noexcept
+    {
+        if constexpr (RandomizedIndividual<TIndividualType>)
+        {
+            individual.reproduce(parentA, parentB, rng);
+        }
+        else
+        {
+            individual.reproduce(parentA, parentB);
+        }
+    }
+
+    /// @brief Initializes the given individual by altering an existing individual.
+    ///
+    /// @param individual The individual to initialize.
+    /// @param parent The parent.
+    /// @param rng The random number generator passed to randomized individuals.
+    static void mutate(TIndividualType            &individual,
+                       TIndividualType const      &parent,
+                       std::default_random_engine &rng) noexcept
+    {
+        if constexpr (RandomizedIndividual<TIndividualType>)
+        {
+            individual.mutate(parent, rng);
+        }
+        else
+        {
+            individual.mutate(parent);
+        }
+    }
+
+    /// @brief Collects the indices of the individuals that are alive and empty.
+    void collectIndices() noexcept
+    {
+        _alive.clear();
+        _empty.clear();
+        for (auto i = 0U; i < _states.size(); ++i)
+        {
+            (_states[i] == State::Empty) ? _empty.push_back(i) : _alive.push_back(i);
+        }
+    }
+
+    /// @brief Refills all empty individuals in one batch, splitting them among the strategies using the ratios.
+    void refill() noexcept
+    {
+        collectIndices();
+        auto const empty = _empty.size();
+        if (empty == 0U)
+        {
+            return;
+        }
+
+        // parents are picked from the index array of the individuals alive, so no empty slots have to be skipped
+        auto const reproductions = (_alive.size() >= 2U) ? roundedShare(empty, _ratios.reproduction) : 0U;
+        auto const mutations =
+            (_alive.size() >= 1U) ? std::min(roundedShare(empty, _ratios.mutation), empty - reproductions) : 0U;
+
+        std::uniform_int_distribution<size_t> dist{0U, _alive.empty() ? 0U : (_alive.size() - 1U)};
+        for (auto i = 0U; i < empty; ++i)
+        {
+            auto const index = _empty[i];
+            if (i < reproductions)
+            {
+                auto const parentA = dist(_rng);
+                auto       parentB = dist(_rng);
+                while (parentA == parentB)
+                {
+                    parentB = dist(_rng);
+                }
+                _states[index] = State::Reproduction;
+                reproduce(_individuals[index], _individuals[_alive[parentA]], _individuals[_alive[parentB]], _rng);
+            }
+            else if (i < (reproductions + mutations))
+            {
+                _states[index] = State::Mutation;
+                mutate(_individuals[index], _individuals[_alive[dist(_rng)]], _rng);
+            }
+            else
+            {
+                _states[index] = State::Init;
+                init(_individuals[index], _rng);
+            }
+            _evaluations[index] = 0U;
+            _fresh[index]       = 1U;
+        }
+    }
+
+    /// @brief Returns the rounded share of the given amount.
+    ///
+    /// @param amount The amount to split.
+    /// @param ratio The ratio of the share.
+    /// @return The rounded share, at most the amount.
+    static size_t roundedShare(size_t const amount, double const ratio) noexcept
+    {
+        return std::min(amount, static_cast<size_t>(std::llround(static_cast<double>(amount) * ratio)));
+    }
+
+    /// @brief Sets the ratios of the strategies to the portions of the parameters.
+    void resetRatios() noexcept
+    {
+        auto const total = _parameters.reproductionPortion + _parameters.mutationPortion + _parameters.reinitPortion;
+        if (total > 0.0)
+        {
+            _ratios.reproduction = _parameters.reproductionPortion / total;
+            _ratios.mutation     = _parameters.mutationPortion / total;
+            _ratios.reinit       = _parameters.reinitPortion / total;
+        }
+        else
+        {
+            _ratios = Ratios{};
+        }
+    }
+
+    /// @brief Moves the ratios towards the share each strategy has of the fresh individuals that survived.
+    ///
+    /// @param freshSurvivors The number of fresh survivors per state of the individuals.
+    /// @remarks A strategy without a slot in the refill creates no survivors, so its ratio could never grow again. The
+    /// ratio of every strategy with a portion above 0 is therefore kept at one slot per refill at least.
+    void updateRatios(std::array<size_t, 4U> const &freshSurvivors) noexcept
+    {
+        auto const reproduction = freshSurvivors[static_cast<size_t>(State::Reproduction)];
+        auto const mutation     = freshSurvivors[static_cast<size_t>(State::Mutation)];
+        auto const reinit       = freshSurvivors[static_cast<size_t>(State::Init)];
+        auto const total        = static_cast<double>(reproduction + mutation + reinit);
+        if (total == 0.0)
+        {
+            return;
+        }
+        auto const dynamics = _parameters.ratioDynamics;
+        if (dynamics == 0.0)
+        {
+            return;
+        }
+        auto const minimum = 1.0 / static_cast<double>(_parameters.population - _parameters.survivors);
+        auto const move    = [&](double const ratio, double const share, double const portion) noexcept {
+            auto const moved = ((1.0 - dynamics) * ratio) + (dynamics * share);
+            return (portion > 0.0) ? std::max(moved, minimum) : moved;
+        };
+        _ratios.reproduction = move(_ratios.reproduction, reproduction / total, _parameters.reproductionPortion);
+        _ratios.mutation     = move(_ratios.mutation, mutation / total, _parameters.mutationPortion);
+        _ratios.reinit       = move(_ratios.reinit, reinit / total, _parameters.reinitPortion);
+
+        auto const sum = _ratios.reproduction + _ratios.mutation + _ratios.reinit;
+        _ratios.reproduction /= sum;
+        _ratios.mutation     /= sum;
+        _ratios.reinit       /= sum;
+    }
+
+    /// @brief Fills the fitness and throughput statistics of the evaluated generation.
+    ///
+    /// @param statistics The statistics to fill, the number of evaluations and their wall time must be set.
+    void summarizeGeneration(Statistics &statistics) noexcept
+    {
+        auto const count      = _fitness.size();
+        statistics.generation = _generation;
+        statistics.population = count;
+        if (statistics.evaluationSeconds > 0.0)
+        {
+            statistics.evaluationsPerSecond = statistics.evaluations / statistics.evaluationSeconds;
+        }
+
+        // every individual is alive and evaluated after the refill, so the dense fitness array is reduced as a whole
+        auto const summary          = summarizeFitness(_fitness.data(), count);
+        auto const mean             = summary.sum / count;
+        statistics.minFitness       = summary.min;
+        statistics.maxFitness       = summary.max;
+        statistics.meanFitness      = mean;
+        statistics.fitnessDeviation = std::sqrt(summary.squaredDeviations / count);
+
+        _sortedFitness.assign(_fitness.begin(), _fitness.end());
+        auto const median = _sortedFitness.begin() + (count / 2U);
+        auto const decile = _sortedFitness.begin() + ((count * 9U) / 10U);
+        std::nth_element(_sortedFitness.begin(), median, _sortedFitness.end());
+        statistics.medianFitness = *median;
+        std::nth_element(median, decile, _sortedFitness.end());
+        statistics.upperDecileFitness = *decile;
+    }
+
+    /// @brief Returns the indices of the evaluated individuals with the highest fitness.
+    ///
+    /// @param count The maximum number of indices to return.
+    /// @return The indices, ordered from highest to lowest fitness.
+    std::vector<std::uint32_t> topIndices(size_t const count) const noexcept
+    {
+        std::vector<std::uint32_t> indices{};
+        for (auto i = 0U; i < _states.size(); ++i)
+        {
+            if ((_states[i] != State::Empty) && (_evaluations[i] != 0U))
+            {
+                indices.push_back(i);
+            }
+        }
+        auto const top    = std::min(count, indices.size());
+        auto const higher = [&](std::uint32_t const a, std::uint32_t const b) noexcept {
+            return _fitness[a] > _fitness[b];
+        };
+        std::partial_sort(indices.begin(), indices.begin() + top, indices.end(), higher);
+        indices.resize(top);
+        return indices;
+    }
+
+    /// @brief Determines the slot an individual evaluated elsewhere is inserted into.
+    ///
+    /// @param fitness The fitness of the individual to insert.
+    /// @return The index of the slot, already set up for the fitness, the caller has to set the individual.
+    size_t insertSlot(double const fitness) noexcept
+    {
+        auto target = _states.size();
+        for (auto i = 0U; i < _states.size(); ++i)
+        {
+            if (_states[i] == State::Empty)
+            {
+                target = i;
+                break;
+            }
+            if ((target == _states.size()) || (_fitness[i] < _fitness[target]))
+            {
+                target = i;
+            }
+        }
+        _states[target]      = State::Init;
+        _fitness[target]     = fitness;
+        _evaluations[target] = 1U;
+        _fresh[target]       = 0U;
+        if constexpr (MultiObjective)
+        {
+            // only the first objective travels with migrants, so the others are determined by evaluating it again
+            _evaluations[target] = 0U;
+        }
+        return target;
+    }
+
+    /// @brief Returns the index of the evaluated individual with the highest fitness.
+    ///
+    /// @return The index of the best individual, the size of the population if none was evaluated yet.
+    size_t bestIndex() const noexcept
+    {
+        auto best = _states.size();
+        for (auto i = 0U; i < _states.size(); ++i)
+        {
+            if ((_states[i] != State::Empty) && (_evaluations[i] != 0U) &&
+                ((best == _states.size()) || (_fitness[i] > _fitness[best])))
+            {
+                best = i;
+            }
+        }
+        return best;
+    }
+
     /// @brief The parameters of the algorithm run.
     Parameters _parameters{};
 
@@ -278,12 +1416,66 @@ private:
     /// @brief The evaluator
     TEvaluatorType _evaluator;
 
-    /// @brief The population to evolve.
-    std::vector<Individual> _population{};
+    // the population is stored as parallel arrays, so selection and statistics scan dense arrays instead of striding
+    // over the potentially large individuals
+
+    /// @brief The state of each individual of the population.
+    std::vector<State> _states{};
+
+    /// @brief The fitness of each individual of the population.
+    std::vector<double> _fitness{};
+
+    /// @brief The number of evaluations the fitness of each individual is averaged over, 0 if it is not valid.
+    std::vector<std::uint32_t> _evaluations{};
+
+    /// @brief Flags marking the individuals filled during the current generation.
+    std::vector<std::uint8_t> _fresh{};
+
+    /// @brief The individuals of the population.
+    std::vector<TIndividualType> _individuals{};
+
+    /// @brief The objectives of each individual of the population, only used with several objectives.
+    std::vector<FitnessType> _objectives{};
+
+    /// @brief The index of the front of each individual, only used with several objectives.
+    std::vector<std::uint32_t> _ranks{};
+
+    /// @brief The crowding distance of each individual, only used with several objectives.
+    std::vector<double> _crowding{};
+
+    /// @brief The indices of the individuals of each front, only used with several objectives.
+    std::vector<std::vector<std::uint32_t>> _fronts{};
+
+    /// @brief The current ratios of the refill strategies.
+    Ratios _ratios{};
+
+    /// @brief The callback receiving the statistics of every generation.
+    std::function<void(Statistics const &)> _statisticsCallback{};
+
+    /// @brief Buffer used to determine the percentiles of the fitness.
+    std::vector<double> _sortedFitness{};
+
+    /// @brief The indices of the individuals alive, used for selecting parents and tournament contestants.
+    std::vector<std::uint32_t> _alive{};
+
+    /// @brief The indices of the empty individuals.
+    std::vector<std::uint32_t> _empty{};
+
+    /// @brief The threads evaluating the population, only used if more than one thread is requested.
+    std::unique_ptr<ThreadPool> _pool{};
+
+    /// @brief The data owned by each evaluation thread.
+    std::unique_ptr<Worker[]> _workers{};
+
+    /// @brief Mutex protecting the population and the index arrays during steady-state runs.
+    std::mutex _mutex{};
 
     /// @brief The random number generator used for filling the grid.
     std::default_random_engine _rng{};
 
+    /// @brief The seed the random number generators of the workers are derived from.
+    std::uint32_t _seed{};
+
     /// @brief The current generation.
     size_t _generation{};
 };
@@ -0,0 +1,214 @@
+#ifndef THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_ISLANDS_HPP
+#define THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_ISLANDS_HPP
+
+#include "THzAutoGaming/optimisation/evolution/algorithm.hpp"
+#include "THzAutoGaming/utility/threadPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Terrahertz::Optimisation::Evolution {
+
+/// @brief Structure containing the parameters of the island model.
+struct IslandParameters
+{
+    /// @brief The number of populations evolving in parallel, each on its own thread.
+    std::uint32_t islands{4U};
+
+    /// @brief The number of generations between two migrations, 0 to disable migration.
+    std::uint32_t migrationInterval{10U};
+
+    /// @brief The number of best individuals each island sends to the next one during a migration.
+    std::uint32_t migrants{2U};
+};
+
+/// @brief Template class running several populations of the evolutionary algorithm, exchanging their best individuals.
+///
+/// @tparam TIndividualType The type of the individuals.
+/// @tparam TEvaluatorType The type of the evaluator.
+/// @remarks Each island is created, resized and evolved by its own thread, which also inserts the migrants it
+/// receives, so its population is allocated by the thread using it and stays local to its NUMA node if the operating
+/// system keeps the thread there. During a migration every island sends copies of its best individuals to the next
+/// island of a ring. To spread islands over processes instead, use
+/// Algorithm::emigrate and Algorithm::immigrate with files shared by the processes.
+template <CopyableIndividual TIndividualType, Evaluator<TIndividualType> TEvaluatorType>
+class Islands
+{
+public:
+    /// @brief The type of the algorithm running on each island.
+    using AlgorithmType = Algorithm<TIndividualType, TEvaluatorType>;
+
+    /// @brief Initializes a new Islands instance.
+    ///
+    /// @param islandParameters The parameters of the island model, at least one island is created.
+    /// @param rootIndividual The individual all others will be copied from, used for handing in external information.
+    /// @param evaluator The evaluator instance copied to each island.
+    Islands(IslandParameters const &islandParameters = {},
+            TIndividualType         rootIndividual   = {},
+            TEvaluatorType          evaluator        = {}) noexcept
+        : _islandParameters{islandParameters},
+          _pool{std::max(islandParameters.islands, 1U)},
+          _islands{std::make_unique<std::unique_ptr<AlgorithmType>[]>(_pool.threadCount())},
+          _migrants(_pool.threadCount())
+    {
+        _islandParameters.islands = _pool.threadCount();
+        _pool.run([&](std::uint32_t const index) noexcept {
+            _islands[index] = std::make_unique<AlgorithmType>(rootIndividual, evaluator);
+            _islands[index]->seed(index + 1U);
+        });
+    }
+
+    /// @brief Returns the parameters of the island model.
+    ///
+    /// @return The parameters of the island model.
+    IslandParameters const &islandParameters() const noexcept { return _islandParameters; }
+
+    /// @brief Returns the parameters of the algorithm running on each island.
+    ///
+    /// @return The parameters of the algorithms.
+    Parameters const &parameters() const noexcept { return _islands[0U]->parameters(); }
+
+    /// @brief Sets the parameters of the algorithm running on each island.
+    ///
+    /// @param parameters The new parameters for the algorithms to use.
+    /// @return True if the parameters were set, false if they are invalid.
+    bool setParameters(Parameters const &parameters) noexcept
+    {
+        // the populations are resized by the threads using them, all islands reject invalid parameters alike
+        bool accepted{};
+        _pool.run([&](std::uint32_t const index) noexcept {
+            auto const result = _islands[index]->setParameters(parameters);
+            if (index == 0U)
+            {
+                accepted = result;
+            }
+        });
+        return accepted;
+    }
+
+    /// @brief Returns the algorithm running on the given island.
+    ///
+    /// @param index The index of the island.
+    /// @return The algorithm of the island.
+    AlgorithmType const &island(size_t const index) const noexcept { return *_islands[index]; }
+
+    /// @brief Provides access to the algorithm running on the given island.
+    ///
+    /// @param index The index of the island.
+    /// @return The algorithm of the island.
+    /// @remarks Must not be called while the islands are running, e.g. from the predicate of runUntil.
+    AlgorithmType &island(size_t const index) noexcept { return *_islands[index]; }
+
+    /// @brief Runs one generation on every island in parallel, followed by a migration if one is due.
+    void runOnce() noexcept
+    {
+        _pool.run([&](std::uint32_t const index) noexcept { _islands[index]->runOnce(); });
+        ++_generation;
+        if ((_islandParameters.migrationInterval != 0U) && ((_generation % _islandParameters.migrationInterval) == 0U))
+        {
+            migrate();
+        }
+    }
+
+    /// @brief Runs generations until the given predicate is satisfied.
+    ///
+    /// @tparam TFunctor The type of the predicate.
+    /// @param predicate Called with the islands before each generation, returns true to stop the evolution.
+    /// @return The number of generations run.
+    template <typename TFunctor>
+    size_t runUntil(TFunctor const &predicate) noexcept
+    {
+        size_t generations{};
+        while (!predicate(static_cast<Islands const &>(*this)))
+        {
+            runOnce();
+            ++generations;
+        }
+        return generations;
+    }
+
+    /// @brief Returns the current generation of the islands.
+    ///
+    /// @return The current generation of the islands.
+    size_t generation() const noexcept { return _generation; }
+
+    /// @brief Returns the evaluated individual with the highest fitness of all islands.
+    ///
+    /// @return The best individual, the root individual of the first island if none was evaluated yet.
+    TIndividualType const &bestIndividual() const noexcept { return _islands[bestIsland()]->bestIndividual(); }
+
+    /// @brief Returns the highest fitness of all islands.
+    ///
+    /// @return The highest fitness, the lowest double if no individual was evaluated yet.
+    double bestFitness() const noexcept { return _islands[bestIsland()]->bestFitness(); }
+
+private:
+    /// @brief Structure containing the individuals sent by an island during a migration.
+    struct Migrants
+    {
+        /// @brief Copies of the best individuals of the island.
+        std::vector<TIndividualType> individuals{};
+
+        /// @brief The fitness of the individuals.
+        std::vector<double> fitness{};
+    };
+
+    /// @brief Sends the best individuals of each island to the next island.
+    ///
+    /// @remarks Each island copies its own migrants and inserts the ones it receives on its own thread, so the copies
+    /// placed in its population are allocated by that thread.
+    void migrate() noexcept
+    {
+        // all migrants are collected before any is inserted, so individuals only move by one island per migration
+        auto const islands = _islandParameters.islands;
+        _pool.run([&](std::uint32_t const index) noexcept {
+            auto &migrants = _migrants[index];
+            _islands[index]->bestIndividuals(_islandParameters.migrants, migrants.individuals, migrants.fitness);
+        });
+        _pool.run([&](std::uint32_t const index) noexcept {
+            auto const &migrants = _migrants[(index + islands - 1U) % islands];
+            for (auto m = 0U; m < migrants.individuals.size(); ++m)
+            {
+                _islands[index]->insert(migrants.individuals[m], migrants.fitness[m]);
+            }
+        });
+    }
+
+    /// @brief Returns the index of the island with the highest fitness.
+    ///
+    /// @return The index of the island.
+    size_t bestIsland() const noexcept
+    {
+        size_t best{};
+        for (auto i = 1U; i < _islandParameters.islands; ++i)
+        {
+            if (_islands[i]->bestFitness() > _islands[best]->bestFitness())
+            {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    /// @brief The parameters of the island model.
+    IslandParameters _islandParameters{};
+
+    /// @brief The threads running the islands, thread i always runs island i.
+    ThreadPool _pool;
+
+    /// @brief The algorithms of the islands.
+    std::unique_ptr<std::unique_ptr<AlgorithmType>[]> _islands{};
+
+    /// @brief The buffers of the migrants of each island.
+    std::vector<Migrants> _migrants{};
+
+    /// @brief The current generation.
+    size_t _generation{};
+};
+
+} // namespace Terrahertz::Optimisation::Evolution
+
+#endif // !THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_ISLANDS_HPP
@@ -0,0 +1,175 @@
+#ifndef THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_PARETO_HPP
+#define THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_PARETO_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Terrahertz::Optimisation::Evolution {
+
+/// @brief The number of objectives of a fitness type, 0 if the type is not a fitness.
+///
+/// @tparam TFitnessType The type returned by an evaluator.
+template <typename TFitnessType>
+inline constexpr size_t ObjectiveCount = 0U;
+
+/// @brief A single double is the fitness of the scalar mode, higher is better.
+template <>
+inline constexpr size_t ObjectiveCount<double> = 1U;
+
+/// @brief An array of doubles is the fitness of the multi-objective mode, higher is better for every objective.
+template <size_t TObjectives>
+inline constexpr size_t ObjectiveCount<std::array<double, TObjectives>> = TObjectives;
+
+// clang-format off
+
+/// @brief Concept for the fitness returned by an evaluator.
+template <typename TFitnessType>
+concept Fitness = ObjectiveCount<TFitnessType> != 0U;
+
+// clang-format on
+
+/// @brief Checks if the first objectives dominate the second ones.
+///
+/// @tparam TObjectives The number of objectives.
+/// @param a The first objectives.
+/// @param b The second objectives.
+/// @return True if a is at least as high as b in every objective and higher in at least one.
+template <size_t TObjectives>
+bool dominates(std::array<double, TObjectives> const &a, std::array<double, TObjectives> const &b) noexcept
+{
+    auto higher = false;
+    for (auto m = 0U; m < TObjectives; ++m)
+    {
+        if (a[m] < b[m])
+        {
+            return false;
+        }
+        higher = higher || (a[m] > b[m]);
+    }
+    return higher;
+}
+
+/// @brief Sorts the given candidates into fronts of individuals not dominating each other.
+///
+/// @tparam TObjectives The number of objectives.
+/// @param objectives The objectives of all individuals.
+/// @param candidates The indices of the individuals to sort, reordered by the function.
+/// @param ranks Receives the index of the front of each candidate, must have an entry for each individual.
+/// @param fronts Receives the indices of the individuals of each front, its capacity is reused between calls.
+/// @return The number of fronts.
+/// @remarks Uses the efficient non-dominated sort with binary search: after sorting the candidates lexicographically
+/// only earlier candidates can dominate later ones, and each candidate is placed in the first front none of whose
+/// members dominates it, found using a binary search over the fronts. With two objectives only the last member of a
+/// front has to be checked, so sorting takes O(N log N), with more objectives it takes O(M N log N) as long as the
+/// fronts are small and O(M N^2) in the worst case.
+template <size_t TObjectives>
+size_t nonDominatedSort(std::vector<std::array<double, TObjectives>> const &objectives,
+                        std::vector<std::uint32_t>                         &candidates,
+                        std::vector<std::uint32_t>                         &ranks,
+                        std::vector<std::vector<std::uint32_t>>            &fronts) noexcept
+{
+    std::sort(candidates.begin(), candidates.end(), [&](std::uint32_t const a, std::uint32_t const b) noexcept {
+        return objectives[a] > objectives[b];
+    });
+    for (auto &front : fronts)
+    {
+        front.clear();
+    }
+
+    size_t     count{};
+    auto const dominatedBy = [&](std::vector<std::uint32_t> const &front, std::uint32_t const candidate) noexcept {
+        if constexpr (TObjectives == 2U)
+        {
+            // the last member of a front has the highest second objective of all its members
+            return dominates(objectives[front.back()], objectives[candidate]);
+        }
+        else
+        {
+            // members added last are most similar to the candidate, so they are checked first
+            return std::any_of(front.rbegin(), front.rend(), [&](std::uint32_t const member) noexcept {
+                return dominates(objectives[member], objectives[candidate]);
+            });
+        }
+    };
+    for (auto const candidate : candidates)
+    {
+        size_t low{};
+        size_t high{count};
+        while (low < high)
+        {
+            auto const middle = (low + high) / 2U;
+            if (dominatedBy(fronts[middle], candidate))
+            {
+                low = middle + 1U;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        if (low == count)
+        {
+            ++count;
+            if (fronts.size() < count)
+            {
+                fronts.emplace_back();
+            }
+        }
+        fronts[low].push_back(candidate);
+        ranks[candidate] = static_cast<std::uint32_t>(low);
+    }
+    return count;
+}
+
+/// @brief Calculates the crowding distance of the members of a front.
+///
+/// @tparam TObjectives The number of objectives.
+/// @param objectives The objectives of all individuals.
+/// @param front The indices of the members of the front, reordered by the function.
+/// @param distances Receives the crowding distance of each member, must have an entry for each individual.
+/// @remarks The members with the lowest and highest value of an objective get an infinite distance, so the extremes
+/// of the front are always kept. Takes O(M N log N).
+template <size_t TObjectives>
+void crowdingDistance(std::vector<std::array<double, TObjectives>> const &objectives,
+                      std::vector<std::uint32_t>                         &front,
+                      std::vector<double>                                &distances) noexcept
+{
+    for (auto const member : front)
+    {
+        distances[member] = 0.0;
+    }
+    if (front.size() <= 2U)
+    {
+        for (auto const member : front)
+        {
+            distances[member] = std::numeric_limits<double>::infinity();
+        }
+        return;
+    }
+    for (auto m = 0U; m < TObjectives; ++m)
+    {
+        std::sort(front.begin(), front.end(), [&](std::uint32_t const a, std::uint32_t const b) noexcept {
+            return objectives[a][m] < objectives[b][m];
+        });
+        auto const range = objectives[front.back()][m] - objectives[front.front()][m];
+
+        distances[front.front()] = std::numeric_limits<double>::infinity();
+        distances[front.back()]  = std::numeric_limits<double>::infinity();
+        if (range <= 0.0)
+        {
+            continue;
+        }
+        for (auto i = 1U; (i + 1U) < front.size(); ++i)
+        {
+            distances[front[i]] += (objectives[front[i + 1U]][m] - objectives[front[i - 1U]][m]) / range;
+        }
+    }
+}
+
+} // namespace Terrahertz::Optimisation::Evolution
+
+#endif // !THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_PARETO_HPP
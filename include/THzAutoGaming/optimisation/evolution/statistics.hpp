@@ -0,0 +1,120 @@
+#ifndef THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_STATISTICS_HPP
+#define THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace Terrahertz::Optimisation::Evolution {
+
+/// @brief Structure containing the statistics of a single generation of the evolutionary algorithm.
+struct Statistics
+{
+    /// @brief The generation the statistics belong to, starting at 0.
+    size_t generation{};
+
+    /// @brief The number of individuals competing in the generation.
+    size_t population{};
+
+    /// @brief The lowest fitness of the generation.
+    double minFitness{};
+
+    /// @brief The mean fitness of the generation.
+    double meanFitness{};
+
+    /// @brief The highest fitness of the generation.
+    double maxFitness{};
+
+    /// @brief The median fitness of the generation.
+    double medianFitness{};
+
+    /// @brief The fitness exceeded by the best 10 percent of the generation.
+    double upperDecileFitness{};
+
+    /// @brief The standard deviation of the fitness, used as a proxy for the diversity of the population.
+    double fitnessDeviation{};
+
+    /// @brief The number of individuals created by reinitialisation in this generation that survived.
+    size_t initSurvivors{};
+
+    /// @brief The number of individuals created by reproduction in this generation that survived.
+    size_t reproductionSurvivors{};
+
+    /// @brief The number of individuals created by mutation in this generation that survived.
+    size_t mutationSurvivors{};
+
+    /// @brief The number of evaluations done in the generation.
+    size_t evaluations{};
+
+    /// @brief The wall time spent evaluating the generation.
+    double evaluationSeconds{};
+
+    /// @brief The number of evaluations per second of wall time.
+    double evaluationsPerSecond{};
+};
+
+/// @brief Structure containing the result of summarizeFitness.
+struct FitnessSummary
+{
+    /// @brief The lowest value.
+    double min{};
+
+    /// @brief The highest value.
+    double max{};
+
+    /// @brief The sum of all values.
+    double sum{};
+
+    /// @brief The sum of the squared deviations of all values from their mean.
+    double squaredDeviations{};
+};
+
+/// @brief Calculates the minimum, maximum, sum and sum of squared deviations of the given fitness values.
+///
+/// @remarks Uses two passes, the deviations are taken from the mean determined by the first one. This stays accurate
+/// when the deviation is small compared to the mean, unlike subtracting the squared mean from the mean of squares.
+///
+/// @param fitness The fitness values.
+/// @param count The number of fitness values, at least 1.
+/// @return The summary of the values.
+FitnessSummary summarizeFitness(double const *fitness, size_t const count) noexcept;
+
+/// @brief Enumeration of the formats of the StatisticsWriter.
+enum class StatisticsFormat
+{
+    // comma separated values with a header line
+    Csv,
+
+    // one JSON object per line
+    JsonLines
+};
+
+/// @brief Callback writing the statistics of each generation to a stream.
+class StatisticsWriter
+{
+public:
+    /// @brief Initializes a new StatisticsWriter.
+    ///
+    /// @param stream The stream to write to, must outlive the writer.
+    /// @param format The format to write.
+    StatisticsWriter(std::ostream &stream, StatisticsFormat const format) noexcept;
+
+    /// @brief Writes the given statistics as a single line, the first CSV line is preceded by the header.
+    ///
+    /// @param statistics The statistics to write.
+    void operator()(Statistics const &statistics) noexcept;
+
+private:
+    /// @brief The stream to write to.
+    std::ostream *_stream{};
+
+    /// @brief The format to write.
+    StatisticsFormat _format{};
+
+    /// @brief True if the CSV header was written already.
+    bool _headerWritten{};
+};
+
+} // namespace Terrahertz::Optimisation::Evolution
+
+#endif // !THZ_AUTOGAMING_OPTIMISATION_EVOLUTION_STATISTICS_HPP
@@ -0,0 +1,1064 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_BASICTILEMATCHINGPUZZLE_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_BASICTILEMATCHINGPUZZLE_HPP
+
+#include "THzAutoGaming/simulations/collapseRules.hpp"
+#include "THzAutoGaming/simulations/tileMatchingTypes.hpp"
+#include "THzAutoGaming/utility/xoshiro256.hpp"
+#include "THzCommon/utility/spanhelpers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl>
+#include <type_traits>
+#include <vector>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Extent of a BasicTileMatchingPuzzle that is passed to the constructor instead of being known at compile time.
+inline constexpr std::uint8_t DynamicExtent{0U};
+
+/// @brief Simulation of a tile matching puzzle, the implementation behind all grid based puzzles of this library.
+///
+/// @tparam TWidth The width of the grid, DynamicExtent if it is passed to the constructor.
+/// @tparam THeight The height of the grid, DynamicExtent if it is passed to the constructor.
+/// @tparam TTypeCount The number of different tile types, DynamicExtent if it is passed to the constructor.
+/// @tparam TRules The rules deciding how groups collapse, see PlainRules and SpecialTileRules.
+/// @tparam THashed True if the Zobrist hash of the grid is updated whenever a tile changes instead of being calculated
+/// by hash(), which makes hash() cheap but every simulation slower.
+/// @remarks TileMatchingPuzzle is this template using dynamic extents and plain rules. With extents known at
+/// compile time all buffers are stored inline and loop bounds are constants, so copies, snapshots and simulations into
+/// a caller supplied buffer never touch the heap. Only simulate() without a buffer keeps its collapses in a vector,
+/// which is grown when necessary and keeps its capacity between calls.
+template <std::uint8_t  TWidth,
+          std::uint8_t  THeight,
+          std::uint8_t  TTypeCount,
+          CollapseRules TRules  = PlainRules,
+          bool          THashed = false>
+class BasicTileMatchingPuzzle : public TileMatchingTypes
+{
+public:
+    /// @brief True if the grid size and type count are passed to the constructor.
+    static constexpr bool IsDynamic{TWidth == DynamicExtent};
+
+    static_assert(((THeight == DynamicExtent) == IsDynamic) && ((TTypeCount == DynamicExtent) == IsDynamic),
+                  "Either all or none of the extents have to be dynamic");
+    static_assert(TTypeCount <= TRules::MaxTypeCount, "Type count out of range");
+
+    /// @brief The number of tiles in the grid, 0 if the extents are dynamic.
+    static constexpr size_t TileCount{static_cast<size_t>(TWidth) * THeight};
+
+private:
+    /// @brief Storage of a buffer with one entry per tile or column, inline if the extents are known at compile time.
+    ///
+    /// @tparam TValue The type of the entries.
+    /// @tparam TCount The number of entries if the extents are known at compile time.
+    template <typename TValue, size_t TCount>
+    using Buffer = std::conditional_t<IsDynamic, std::vector<TValue>, std::array<TValue, TCount>>;
+
+    /// @brief The maximum number of collapses of a single wave.
+    ///
+    /// @param tileCount The number of tiles in the grid.
+    /// @return The maximum number of collapses of a single wave.
+    /// @remarks Lines of the same direction do not overlap and contain at least 3 tiles, so there are less groups than
+    /// tiles. Each special tile triggered adds at most one more collapse.
+    static constexpr size_t waveCapacity(size_t const tileCount) noexcept
+    {
+        return TRules::ShapeAware ? (2U * tileCount) : tileCount;
+    }
+
+public:
+    /// @brief Compact copy of the grid and random number generator, used to branch and roll back simulations.
+    ///
+    /// @remarks With dynamic extents the tiles are stored on the heap, so copying a state allocates. Callers on hot
+    /// paths should keep their states and refill them using snapshot() instead.
+    struct State
+    {
+        /// @brief The width of the grid the state was taken from.
+        std::uint8_t width{};
+
+        /// @brief The height of the grid the state was taken from.
+        std::uint8_t height{};
+
+        /// @brief The type of each tile, stored column by column.
+        Buffer<std::uint8_t, TileCount> tiles{};
+
+        /// @brief The state of the random number generator used for filling the grid.
+        Xoshiro256 rng{};
+    };
+
+    /// @brief Initializes a new simulation instance with extents known at compile time.
+    ///
+    /// @param seed The seed of the random number generator used for filling the grid.
+    BasicTileMatchingPuzzle(std::uint64_t const seed = Xoshiro256::DefaultSeed) noexcept
+        requires(!IsDynamic)
+        : _rng{seed}
+    {
+        simulate(gsl::span<Collapse>{});
+    }
+
+    /// @brief Initializes a new simulation instance with dynamic extents.
+    ///
+    /// @param pWidth The width of the grid.
+    /// @param pHeight The height of the grid.
+    /// @param pTypeCount The number of different tile types.
+    /// @param seed The seed of the random number generator used for filling the grid.
+    BasicTileMatchingPuzzle(std::uint8_t const  pWidth,
+                            std::uint8_t const  pHeight,
+                            std::uint8_t const  pTypeCount,
+                            std::uint64_t const seed = Xoshiro256::DefaultSeed) noexcept
+        requires IsDynamic
+        : _rng{seed}, _extents{pWidth, pHeight, pTypeCount}
+    {
+        auto const tileCount = static_cast<size_t>(pWidth) * pHeight;
+        _types.resize(tileCount);
+        _horizontalGroupIds.resize(tileCount);
+        _verticalGroupIds.resize(tileCount);
+        _dirtyRows.resize(pWidth);
+        _groups.resize(tileCount + 1U);
+        _waveCollapses.resize(waveCapacity(tileCount));
+        _collapses.resize(tileCount);
+        if constexpr (TRules::ShapeAware)
+        {
+            _shapes.lineStarts.resize(tileCount + 1U);
+            _shapes.lineLengths.resize(tileCount + 1U);
+            _shapes.triggers.resize(tileCount);
+            _shapes.triggerTiles.resize(tileCount);
+            _shapes.spawnIndices.resize(waveCapacity(tileCount));
+        }
+        simulate(gsl::span<Collapse>{});
+    }
+
+    /// @brief Returns the width of the grid.
+    ///
+    /// @return The width of the grid.
+    static constexpr std::uint8_t width() noexcept
+        requires(!IsDynamic)
+    {
+        return TWidth;
+    }
+
+    /// @brief Returns the width of the grid.
+    ///
+    /// @return The width of the grid.
+    std::uint8_t width() const noexcept
+        requires IsDynamic
+    {
+        return _extents.width;
+    }
+
+    /// @brief Returns the height of the grid.
+    ///
+    /// @return The height of the grid.
+    static constexpr std::uint8_t height() noexcept
+        requires(!IsDynamic)
+    {
+        return THeight;
+    }
+
+    /// @brief Returns the height of the grid.
+    ///
+    /// @return The height of the grid.
+    std::uint8_t height() const noexcept
+        requires IsDynamic
+    {
+        return _extents.height;
+    }
+
+    /// @brief Returns the number of different tile types.
+    ///
+    /// @return The number of different tile types.
+    static constexpr std::uint8_t typeCount() noexcept
+        requires(!IsDynamic)
+    {
+        return TTypeCount;
+    }
+
+    /// @brief Returns the number of different tile types.
+    ///
+    /// @return The number of different tile types.
+    std::uint8_t typeCount() const noexcept
+        requires IsDynamic
+    {
+        return _extents.typeCount;
+    }
+
+    /// @brief Provides access to the random number generator used for filling the grid.
+    ///
+    /// @return The random number generator used for filling the grid.
+    /// @remarks Can be used to reseed the puzzle or to split off streams for parallel rollouts.
+    Xoshiro256 &rng() noexcept { return _rng; }
+
+    /// @brief Returns the Zobrist hash of the grid.
+    ///
+    /// @return The hash of the grid.
+    /// @remarks Grids with the same tiles, size and type count have the same hash regardless of how they were reached.
+    /// The random number generator is not part of the hash. Calculated from all tiles unless the puzzle is hashed.
+    std::uint64_t hash() const noexcept
+    {
+        if constexpr (THashed)
+        {
+            return _hash ^ shapeKey();
+        }
+        else
+        {
+            return tilesHash() ^ shapeKey();
+        }
+    }
+
+    /// @brief Provides access to the tile at the given coordinates.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The content of the tile, 0xFF if the tile is out of range.
+    std::uint8_t operator()(std::uint8_t const x, std::uint8_t const y) const noexcept
+    {
+        if ((x >= width()) || (y >= height()))
+        {
+            return ErrorTile;
+        }
+        return _types[index(x, y)];
+    }
+
+    /// @brief Sets a new value for the tile at the given coordinates.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @param newContent The new value of the tile.
+    /// @return True if the tile was set, false if it is out of range or the rules cannot decode the value.
+    bool setTile(std::uint8_t const x, std::uint8_t const y, std::uint8_t const newContent) noexcept
+    {
+        if ((x >= width()) || (y >= height()) || !TRules::isValid(newContent) ||
+            (TRules::matchType(newContent) > typeCount()))
+        {
+            return false;
+        }
+        setType(index(x, y), newContent);
+        return true;
+    }
+
+    /// @brief Swaps the tiles affected by the given move.
+    ///
+    /// @param move The move to perform.
+    /// @return True if the tiles were swapped, false if the move is out of range.
+    bool swapTiles(Move const &move) noexcept
+    {
+        auto const otherX = move.vertical ? move.x : (move.x + 1U);
+        auto const otherY = move.vertical ? (move.y + 1U) : move.y;
+        if ((otherX >= width()) || (otherY >= height()))
+        {
+            return false;
+        }
+        auto const i     = index(move.x, move.y);
+        auto const other = index(otherX, otherY);
+        auto const type  = _types[i];
+        setType(i, _types[other]);
+        setType(other, type);
+        return true;
+    }
+
+    /// @brief Simulates the next step in the game.
+    ///
+    /// @param refill True if the grid shall be refilled after gravity has been applied.
+    /// @return The collapses that happened during simulation.
+    /// @remarks Repeatedly collapses matching tiles and applies gravity until nothing is changed during collapse.
+    gsl::span<Collapse> simulate(bool const refill = true) noexcept
+    {
+        SimulationResult result{};
+        for (auto wave = 0U; wave < 128U; ++wave)
+        {
+            // growing the buffer by the collapses a wave can create at most up front prevents overflows
+            if (_collapses.size() < (result.count + _waveCollapses.size()))
+            {
+                _collapses.resize(result.count + _waveCollapses.size());
+            }
+            if (!step(static_cast<std::uint16_t>(wave), refill, toSpan<Collapse>(_collapses), result))
+            {
+                break;
+            }
+        }
+        return toSpan<Collapse>(_collapses).subspan(0U, result.count);
+    }
+
+    /// @brief Simulates the next step in the game, writing the collapses to the given buffer.
+    ///
+    /// @param collapses The buffer to write the collapses to.
+    /// @param refill True if the grid shall be refilled after gravity has been applied.
+    /// @return The number of collapses written to the buffer and if collapses were dropped as the buffer was full.
+    /// @remarks Never allocates, the grid is always simulated completely, but the collapses that did not fit into the
+    /// buffer are dropped.
+    SimulationResult simulate(gsl::span<Collapse> const collapses, bool const refill = true) noexcept
+    {
+        SimulationResult result{};
+        for (auto wave = 0U; wave < 128U; ++wave)
+        {
+            if (!step(static_cast<std::uint16_t>(wave), refill, collapses, result))
+            {
+                break;
+            }
+        }
+        return result;
+    }
+
+    /// @brief Determines how many tiles the first wave of the next simulation would collapse.
+    ///
+    /// @return The number of tiles that are part of a line of 3 or more, 0 if the grid contains no lines.
+    /// @remarks Single read-only pass over the grid without group bookkeeping or allocations, much cheaper than
+    /// simulate(false) when only the presence or size of the first wave is of interest.
+    size_t peekCollapses() const noexcept
+    {
+        size_t     amount{};
+        auto const columns = static_cast<std::uint32_t>(width());
+        auto const rows    = static_cast<std::uint32_t>(height());
+        auto const typeAt  = [&](size_t const i) noexcept { return TRules::matchType(_types[i]); };
+        if (rows > 64U)
+        {
+            // grids taller than 64 rows do not fit into the row masks, so each tile is checked on its own
+            for (auto x = 0U; x < columns; ++x)
+            {
+                for (auto y = 0U; y < rows; ++y)
+                {
+                    auto const i    = index(x, y);
+                    auto const type = typeAt(i);
+                    if (type == EmptyTile)
+                    {
+                        continue;
+                    }
+                    // a tile is part of a line if it is the first, middle or last tile of a triplet in either direction
+                    auto const left1  = (x > 0U) && (typeAt(i - rows) == type);
+                    auto const left2  = left1 && (x > 1U) && (typeAt(i - rows - rows) == type);
+                    auto const right1 = ((x + 1U) < columns) && (typeAt(i + rows) == type);
+                    auto const right2 = right1 && ((x + 2U) < columns) && (typeAt(i + rows + rows) == type);
+                    auto const up1    = (y > 0U) && (typeAt(i - 1U) == type);
+                    auto const up2    = up1 && (y > 1U) && (typeAt(i - 2U) == type);
+                    auto const down1  = ((y + 1U) < rows) && (typeAt(i + 1U) == type);
+                    auto const down2  = down1 && ((y + 2U) < rows) && (typeAt(i + 2U) == type);
+                    if (left2 || (left1 && right1) || right2 || up2 || (up1 && down1) || down2)
+                    {
+                        ++amount;
+                    }
+                }
+            }
+            return amount;
+        }
+
+        // bit y of a mask is set if the non empty tile in row y matches its neighbour
+        auto const matchesRight = [&](std::uint32_t const x) noexcept -> std::uint64_t {
+            std::uint64_t mask{};
+            if ((x + 1U) < columns)
+            {
+                auto const column = index(x, 0U);
+                for (auto y = 0U; y < rows; ++y)
+                {
+                    auto const type = typeAt(column + y);
+                    mask |= static_cast<std::uint64_t>((type != EmptyTile) & (type == typeAt(column + y + rows))) << y;
+                }
+            }
+            return mask;
+        };
+        std::uint64_t leftLeft{};
+        std::uint64_t left{};
+        auto          right = matchesRight(0U);
+        for (auto x = 0U; x < columns; ++x)
+        {
+            auto const rightRight = matchesRight(x + 1U);
+            auto const horizontal = (leftLeft & left) | (left & right) | (right & rightRight);
+
+            auto const    column = index(x, 0U);
+            std::uint64_t down{};
+            for (auto y = 0U; (y + 1U) < rows; ++y)
+            {
+                auto const type = typeAt(column + y);
+                down |= static_cast<std::uint64_t>((type != EmptyTile) & (type == typeAt(column + y + 1U))) << y;
+            }
+            auto const up       = down << 1U;
+            auto const vertical = ((up << 1U) & up) | (up & down) | (down & (down >> 1U));
+
+            amount += static_cast<size_t>(std::popcount(horizontal | vertical));
+            leftLeft = left;
+            left     = right;
+            right    = rightRight;
+        }
+        return amount;
+    }
+
+    /// @brief Determines all swaps of neighbouring tiles that would result in at least one collapse.
+    ///
+    /// @param moves The buffer to write the moves to.
+    /// @return The number of moves found, if this exceeds the size of the buffer only the first moves were written.
+    /// @remarks Only checks the neighbourhood of the swapped tiles, lines already present in the grid are ignored.
+    size_t legalMoves(gsl::span<Move> moves) const noexcept
+    {
+        size_t     count{};
+        auto const check = [&](Move const &move, std::uint32_t const otherX, std::uint32_t const otherY) noexcept {
+            auto const typeA = TRules::matchType(_types[index(move.x, move.y)]);
+            auto const typeB = TRules::matchType(_types[index(otherX, otherY)]);
+            if ((typeA == typeB) || (typeA == EmptyTile) || (typeB == EmptyTile))
+            {
+                return;
+            }
+            if (formsLine(move.x, move.y, move) || formsLine(otherX, otherY, move))
+            {
+                if (count < moves.size())
+                {
+                    moves[count] = move;
+                }
+                ++count;
+            }
+        };
+        for (auto x = 0U; x < width(); ++x)
+        {
+            for (auto y = 0U; y < height(); ++y)
+            {
+                if ((x + 1U) < width())
+                {
+                    check(Move{static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), false}, x + 1U, y);
+                }
+                if ((y + 1U) < height())
+                {
+                    check(Move{static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), true}, x, y + 1U);
+                }
+            }
+        }
+        return count;
+    }
+
+    /// @brief Stores the current grid and random number generator state in the given state.
+    ///
+    /// @param state The state to write to.
+    /// @remarks Only allocates the first time a state with dynamic extents is used for a grid of this size, reusing a
+    /// state is allocation free.
+    void snapshot(State &state) const noexcept
+    {
+        state.width  = width();
+        state.height = height();
+        state.tiles  = _types;
+        state.rng    = _rng;
+    }
+
+    /// @brief Restores the grid and random number generator from the given state.
+    ///
+    /// @param state The state to restore.
+    /// @return True if the state was restored, false if it does not fit the width and height of the grid.
+    /// @remarks The state is expected to be created by snapshot() of a puzzle with the same type count.
+    bool restore(State const &state) noexcept
+    {
+        if ((state.width != width()) || (state.height != height()) || (state.tiles.size() != _types.size()))
+        {
+            return false;
+        }
+        _types = state.tiles;
+        if constexpr (THashed)
+        {
+            _hash = tilesHash();
+        }
+        _rng = state.rng;
+        return true;
+    }
+
+private:
+    /// @brief Returns the Zobrist key of the given tile type at the given position of the grid.
+    ///
+    /// @param i The index of the tile in the grid.
+    /// @param type The type of the tile.
+    /// @return The key of the tile, 0 for EmptyTile so empty tiles do not contribute to the hash.
+    /// @remarks The keys are derived from the position and type instead of being stored in a table, so copying a
+    /// puzzle stays cheap and puzzles of the same size share their keys.
+    static constexpr std::uint64_t zobristKey(size_t const i, std::uint8_t const type) noexcept
+    {
+        if (type == EmptyTile)
+        {
+            return 0U;
+        }
+        auto z = ((static_cast<std::uint64_t>(i) << 8U) | type) * 0x9E3779B97F4A7C15ULL;
+        z      = (z ^ (z >> 32U)) * 0xBF58476D1CE4E5B9ULL;
+        return z ^ (z >> 29U);
+    }
+
+    /// @brief Returns the key of the grid size and type count, so grids of other puzzles do not share hashes.
+    ///
+    /// @return The key of the grid size and type count.
+    std::uint64_t shapeKey() const noexcept
+    {
+        // mixed like the keys of the tiles, using bits no tile index reaches
+        auto z = ((static_cast<std::uint64_t>(width()) << 48U) | (static_cast<std::uint64_t>(height()) << 40U) |
+                  (static_cast<std::uint64_t>(typeCount()) << 32U)) *
+                 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 32U)) * 0xBF58476D1CE4E5B9ULL;
+        return z ^ (z >> 29U);
+    }
+
+    /// @brief Calculates the Zobrist hash of the tiles from scratch.
+    ///
+    /// @return The hash of the tiles, 0 for an empty grid.
+    std::uint64_t tilesHash() const noexcept
+    {
+        std::uint64_t result{};
+        for (auto i = 0U; i < _types.size(); ++i)
+        {
+            result ^= zobristKey(i, _types[i]);
+        }
+        return result;
+    }
+
+    /// @brief Returns the index of the given tile.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The index of the tile.
+    size_t index(std::uint32_t const x, std::uint32_t const y) const noexcept
+    {
+        return (static_cast<size_t>(x) * height()) + y;
+    }
+
+    /// @brief Changes the type of the given tile, keeping the hash up to date.
+    ///
+    /// @param i The index of the tile.
+    /// @param type The new type of the tile.
+    void setType(size_t const i, std::uint8_t const type) noexcept
+    {
+        if constexpr (THashed)
+        {
+            _hash ^= zobristKey(i, _types[i]) ^ zobristKey(i, type);
+        }
+        _types[i] = type;
+    }
+
+    /// @brief Checks if the given tile would be part of a line after swapping two tiles.
+    ///
+    /// @param x The row of the tile to check.
+    /// @param y The column of the tile to check.
+    /// @param move The swap to check.
+    /// @return True if the tile would be part of a line, false otherwise.
+    bool formsLine(std::uint32_t const x, std::uint32_t const y, Move const &move) const noexcept
+    {
+        auto const otherX = move.vertical ? move.x : (move.x + 1U);
+        auto const otherY = move.vertical ? (move.y + 1U) : move.y;
+        // returns the type of the given tile as it would be after the swap
+        auto const typeAt = [&](std::uint32_t const tx, std::uint32_t const ty) noexcept -> std::uint8_t {
+            if ((tx == move.x) && (ty == move.y))
+            {
+                return TRules::matchType(_types[index(otherX, otherY)]);
+            }
+            if ((tx == otherX) && (ty == otherY))
+            {
+                return TRules::matchType(_types[index(move.x, move.y)]);
+            }
+            return TRules::matchType(_types[index(tx, ty)]);
+        };
+
+        auto const type = typeAt(x, y);
+        auto       run  = 1U;
+        for (auto tx = x; (tx > 0U) && (typeAt(tx - 1U, y) == type) && (run < 3U); --tx)
+        {
+            ++run;
+        }
+        for (auto tx = x + 1U; (tx < width()) && (typeAt(tx, y) == type) && (run < 3U); ++tx)
+        {
+            ++run;
+        }
+        if (run >= 3U)
+        {
+            return true;
+        }
+
+        run = 1U;
+        for (auto ty = y; (ty > 0U) && (typeAt(x, ty - 1U) == type) && (run < 3U); --ty)
+        {
+            ++run;
+        }
+        for (auto ty = y + 1U; (ty < height()) && (typeAt(x, ty) == type) && (run < 3U); ++ty)
+        {
+            ++run;
+        }
+        return run >= 3U;
+    }
+
+    /// @brief Runs a single wave of the simulation.
+    ///
+    /// @param wave The current wave of the simulation.
+    /// @param refill True if the grid shall be refilled after gravity has been applied.
+    /// @param collapses The buffer to write the collapses to.
+    /// @param result The number of collapses already in the buffer and the overflow flag, updated by this method.
+    /// @return True if there were any changes to the grid, false otherwise.
+    bool step(std::uint16_t const       wave,
+              bool const                refill,
+              gsl::span<Collapse> const collapses,
+              SimulationResult         &result) noexcept
+    {
+        // the grid may have been altered from outside since the last call, so the first wave checks all tiles
+        collapse(wave, wave == 0U);
+        for (auto c = 0U; c < _waveCount; ++c)
+        {
+            // collapses merged into others are left empty
+            if (_waveCollapses[c].type == EmptyTile)
+            {
+                continue;
+            }
+            if (result.count == collapses.size())
+            {
+                result.overflow = true;
+                break;
+            }
+            collapses[result.count++] = _waveCollapses[c];
+        }
+
+        auto changes = gravity();
+        // we cannot check skipped here, because if a cell in the top row is empty
+        // gravity would return false but fill would still need to run
+        if (refill)
+        {
+            // we do not need to remember the result of gravity
+            // because if gravity changed something fill will change something as well
+            changes = fill();
+        }
+        return changes;
+    }
+
+    /// @brief Collapses all lines of similar cells that are 3 tiles or longer.
+    ///
+    /// @param wave The current wave of the simulation.
+    /// @param fullScan True if the entire grid shall be checked, false to only check the region around changed tiles.
+    /// @remarks The collapses of the wave are stored in _waveCollapses.
+    void collapse(std::uint16_t const wave, bool const fullScan) noexcept
+    {
+        std::uint16_t nextGroupId = 1U;
+        auto const    columns     = static_cast<std::uint32_t>(width());
+        auto const    rows        = static_cast<std::uint32_t>(height());
+        _waveCount                = 0U;
+
+        // all lines present before the last collapse have been removed, so a new line has to contain at least one of
+        // the tiles changed since then, this allows us to limit the search to the region around those tiles
+        std::uint32_t firstColumn{};
+        std::uint32_t endColumn{};
+        std::uint32_t endRow{};
+        if (fullScan)
+        {
+            std::fill(_dirtyRows.begin(), _dirtyRows.end(), height());
+            endColumn = columns;
+            endRow    = rows;
+        }
+        else
+        {
+            firstColumn = columns;
+            for (auto x = 0U; x < columns; ++x)
+            {
+                if (_dirtyRows[x] != 0U)
+                {
+                    firstColumn = std::min(firstColumn, x);
+                    endColumn   = x + 1U;
+                    endRow      = std::max<std::uint32_t>(endRow, _dirtyRows[x]);
+                }
+            }
+            if (endRow == 0U)
+            {
+                return;
+            }
+            // lines containing a changed tile reach at most two tiles beyond it
+            firstColumn = (firstColumn > 2U) ? (firstColumn - 2U) : 0U;
+            endColumn   = std::min(endColumn + 2U, columns);
+            endRow      = std::min(endRow + 2U, rows);
+        }
+
+        auto const checkTriplet = [&](size_t const first, size_t const step, auto &groupIds) noexcept {
+            auto const type = TRules::matchType(_types[first]);
+            if ((type != EmptyTile) && (type == TRules::matchType(_types[first + step])) &&
+                (type == TRules::matchType(_types[first + step + step])))
+            {
+                auto const extends            = groupIds[first] != 0U;
+                auto const id                 = extends ? groupIds[first] : nextGroupId++;
+                groupIds[first]               = id;
+                groupIds[first + step]        = id;
+                groupIds[first + step + step] = id;
+                if constexpr (TRules::ShapeAware)
+                {
+                    if (extends)
+                    {
+                        // each further triplet of a line adds one tile to it
+                        ++_shapes.lineLengths[id];
+                    }
+                    else
+                    {
+                        auto const start        = (step == 1U) ? (first % rows) : (first / rows);
+                        _shapes.lineStarts[id]  = static_cast<std::uint8_t>(start);
+                        _shapes.lineLengths[id] = 3U;
+                    }
+                }
+            }
+        };
+
+        // look for groups vertically, only triplets starting in the changed rows of a column need to be checked
+        auto const lastVerticalStart = (rows > 2U) ? (rows - 2U) : 0U;
+        for (auto x = firstColumn; x < endColumn; ++x)
+        {
+            auto const starts = std::min<std::uint32_t>(_dirtyRows[x], lastVerticalStart);
+            for (auto y = 0U; y < starts; ++y)
+            {
+                checkTriplet(index(x, y), 1U, _verticalGroupIds);
+            }
+        }
+
+        // look for groups horizontally, only triplets containing a changed tile need to be checked
+        for (auto x = firstColumn; (x + 2U) < endColumn; ++x)
+        {
+            auto const changedRows = std::max({_dirtyRows[x], _dirtyRows[x + 1U], _dirtyRows[x + 2U]});
+            for (auto y = 0U; y < changedRows; ++y)
+            {
+                checkTriplet(index(x, y), rows, _horizontalGroupIds);
+            }
+        }
+        std::fill(_dirtyRows.begin(), _dirtyRows.end(), std::uint8_t{});
+
+        // final analysis
+        std::fill_n(_groups.begin(), nextGroupId, 0U);
+        for (auto x = firstColumn; x < endColumn; ++x)
+        {
+            for (auto y = 0U; y < endRow; ++y)
+            {
+                auto const i            = index(x, y);
+                auto const horizontalId = _horizontalGroupIds[i];
+                auto const verticalId   = _verticalGroupIds[i];
+                if ((horizontalId == 0U) && (verticalId == 0U))
+                {
+                    continue;
+                }
+                auto const id = (horizontalId != 0U) ? horizontalId : verticalId;
+                if ((horizontalId != 0U) && (verticalId != 0U))
+                {
+                    auto &groupH = _groups[horizontalId];
+                    auto &groupV = _groups[verticalId];
+                    if (groupH != groupV)
+                    {
+                        auto &collapseH = _waveCollapses[accessCollapse(groupH, wave)];
+                        auto &collapseV = _waveCollapses[accessCollapse(groupV, wave)];
+                        collapseH.amount += collapseV.amount;
+                        if constexpr (TRules::ShapeAware)
+                        {
+                            if (collapseV.shape > collapseH.shape)
+                            {
+                                collapseH.shape                     = collapseV.shape;
+                                _shapes.spawnIndices[groupH - 1U] = _shapes.spawnIndices[groupV - 1U];
+                            }
+                        }
+                        collapseV.type   = EmptyTile;
+                        collapseV.amount = 0U;
+                        groupV           = groupH;
+                    }
+                    else if (groupH == 0U)
+                    {
+                        // the tile starts both lines, so they share a new collapse
+                        accessCollapse(groupH, wave);
+                        groupV = groupH;
+                    }
+                }
+
+                auto const c        = accessCollapse(_groups[id], wave);
+                auto      &collapse = _waveCollapses[c];
+                collapse.type       = TRules::matchType(_types[i]);
+                ++collapse.amount;
+                if constexpr (TRules::ShapeAware)
+                {
+                    // the tile determining the shape of the group gets replaced by the special tile
+                    auto const shape = tileShape(x, y, horizontalId, verticalId);
+                    if (shape > collapse.shape)
+                    {
+                        collapse.shape          = shape;
+                        _shapes.spawnIndices[c] = static_cast<std::uint16_t>(i);
+                    }
+                    if (TRules::isSpecial(_types[i]))
+                    {
+                        _shapes.triggers[_shapes.triggerCount++] = static_cast<std::uint16_t>(i);
+                        _shapes.triggerTiles[i]                  = _types[i];
+                    }
+                }
+
+                // reset tile
+                setType(i, EmptyTile);
+                _horizontalGroupIds[i] = 0U;
+                _verticalGroupIds[i]   = 0U;
+            }
+        }
+
+        if constexpr (TRules::ShapeAware)
+        {
+            triggerSpecials(wave);
+            spawnSpecials();
+        }
+    }
+
+    /// @brief Returns the index of the collapse of the given group, adding a new collapse if necessary.
+    ///
+    /// @param group The entry of the group in _groups, 0 if the group has no collapse yet.
+    /// @param wave The current wave of the simulation.
+    /// @return The index of the collapse in _waveCollapses.
+    size_t accessCollapse(std::uint32_t &group, std::uint16_t const wave) noexcept
+    {
+        if (group == 0U)
+        {
+            // reuse the slots of collapses merged into others
+            while ((group < _waveCount) && (_waveCollapses[group].type != EmptyTile))
+            {
+                ++group;
+            }
+            if (group == _waveCount)
+            {
+                ++_waveCount;
+            }
+            _waveCollapses[group] = Collapse{.type = EmptyTile, .wave = wave};
+            ++group;
+        }
+        return static_cast<size_t>(group) - 1U;
+    }
+
+    /// @brief Returns the shape the given tile of a group contributes to the shape of the entire group.
+    ///
+    /// @param x The row of the tile.
+    /// @param y The column of the tile.
+    /// @param horizontalId The id of the horizontal line the tile belongs to, 0 for none.
+    /// @param verticalId The id of the vertical line the tile belongs to, 0 for none.
+    /// @return The shape of the lines the tile is part of.
+    Shape tileShape(std::uint32_t const x,
+                    std::uint32_t const y,
+                    std::uint16_t const horizontalId,
+                    std::uint16_t const verticalId) const noexcept
+        requires TRules::ShapeAware
+    {
+        auto const lineShape = [](std::uint32_t const length) noexcept -> Shape {
+            if (length >= 5U)
+            {
+                return Shape::Line5;
+            }
+            return (length == 4U) ? Shape::Line4 : Shape::Line3;
+        };
+        if (verticalId == 0U)
+        {
+            return lineShape(_shapes.lineLengths[horizontalId]);
+        }
+        if (horizontalId == 0U)
+        {
+            return lineShape(_shapes.lineLengths[verticalId]);
+        }
+
+        // the tile connects two lines, check where it is located in each of them
+        auto const horizontalLength = _shapes.lineLengths[horizontalId];
+        auto const verticalLength   = _shapes.lineLengths[verticalId];
+        auto const horizontalStart  = _shapes.lineStarts[horizontalId];
+        auto const verticalStart    = _shapes.lineStarts[verticalId];
+        auto const horizontalEnd    = (x == horizontalStart) || ((x + 1U) == (horizontalStart + horizontalLength));
+        auto const verticalEnd      = (y == verticalStart) || ((y + 1U) == (verticalStart + verticalLength));
+        auto       shape            = Shape::Cross;
+        if (horizontalEnd && verticalEnd)
+        {
+            shape = Shape::L;
+        }
+        else if (horizontalEnd || verticalEnd)
+        {
+            shape = Shape::T;
+        }
+        return std::max({shape, lineShape(horizontalLength), lineShape(verticalLength)});
+    }
+
+    /// @brief Applies the effects of the special tiles that collapsed during the current wave.
+    ///
+    /// @param wave The current wave of the simulation.
+    /// @remarks Adds a collapse for the tiles cleared by each special tile, special tiles cleared this way trigger
+    /// their effects as well.
+    void triggerSpecials(std::uint16_t const wave) noexcept
+        requires TRules::ShapeAware
+    {
+        auto const rows   = static_cast<std::uint32_t>(height());
+        auto const typeAt = [&](std::uint32_t const x, std::uint32_t const y) noexcept -> std::uint8_t {
+            return _types[index(x, y)];
+        };
+        while (_shapes.triggerCount != 0U)
+        {
+            auto const    i    = _shapes.triggers[--_shapes.triggerCount];
+            auto const    tile = _shapes.triggerTiles[i];
+            std::uint16_t amount{};
+            auto const    clear = [&](std::uint32_t const x, std::uint32_t const y) noexcept {
+                auto const cleared = index(x, y);
+                auto const type    = _types[cleared];
+                if (type == EmptyTile)
+                {
+                    return;
+                }
+                if (TRules::isSpecial(type))
+                {
+                    _shapes.triggers[_shapes.triggerCount++] = static_cast<std::uint16_t>(cleared);
+                    _shapes.triggerTiles[cleared]            = type;
+                }
+                setType(cleared, EmptyTile);
+                ++amount;
+            };
+            TRules::trigger(tile, i / rows, i % rows, width(), rows, typeAt, clear);
+            if (amount != 0U)
+            {
+                std::uint32_t group{};
+                auto         &collapse = _waveCollapses[accessCollapse(group, wave)];
+                collapse.type          = TRules::matchType(tile);
+                collapse.shape         = Shape::Effect;
+                collapse.amount        = amount;
+            }
+        }
+    }
+
+    /// @brief Places the special tiles created by the collapses of the current wave.
+    void spawnSpecials() noexcept
+        requires TRules::ShapeAware
+    {
+        for (auto c = 0U; c < _waveCount; ++c)
+        {
+            auto const &collapse = _waveCollapses[c];
+            if (collapse.type != EmptyTile)
+            {
+                auto const tile = TRules::spawn(collapse.type, collapse.shape);
+                if (tile != EmptyTile)
+                {
+                    setType(_shapes.spawnIndices[c], tile);
+                }
+            }
+        }
+    }
+
+    /// @brief Fills up empty cells by moving the content of other cells above into them.
+    ///
+    /// @return True if there were any changes to the grid, false otherwise.
+    bool gravity() noexcept
+    {
+        auto changes = false;
+        for (auto x = 0U; x < width(); ++x)
+        {
+            auto const column = index(x, 0U);
+            // the cell receiving the next tile found above it
+            auto bottom = static_cast<std::uint32_t>(height());
+            for (auto top = static_cast<std::uint32_t>(height()); top != 0U; --top)
+            {
+                auto const type = _types[column + top - 1U];
+                if (type == EmptyTile)
+                {
+                    continue;
+                }
+                --bottom;
+                if (bottom != (top - 1U))
+                {
+                    // the first cell receiving content is the lowest one, everything above it may have changed
+                    if (_dirtyRows[x] == 0U)
+                    {
+                        _dirtyRows[x] = static_cast<std::uint8_t>(bottom + 1U);
+                    }
+                    setType(column + bottom, type);
+                    setType(column + top - 1U, EmptyTile);
+                    changes = true;
+                }
+            }
+        }
+        return changes;
+    }
+
+    /// @brief Fills empty cells with random new values.
+    ///
+    /// @return True if there were any changes to the grid, false otherwise.
+    bool fill() noexcept
+    {
+        auto changes = false;
+        for (auto x = 0U; x < width(); ++x)
+        {
+            for (auto y = 0U; y < height(); ++y)
+            {
+                auto const i = index(x, y);
+                if (_types[i] == EmptyTile)
+                {
+                    setType(i, static_cast<std::uint8_t>(1U + _rng.bounded(typeCount())));
+                    _dirtyRows[x] = std::max(_dirtyRows[x], static_cast<std::uint8_t>(y + 1U));
+                    changes       = true;
+                }
+            }
+        }
+        return changes;
+    }
+
+    /// @brief The width, height and type count of the grid if they are dynamic.
+    struct Extents
+    {
+        /// @brief The width of the grid.
+        std::uint8_t width{};
+
+        /// @brief The height of the grid.
+        std::uint8_t height{};
+
+        /// @brief The number of different tile types.
+        std::uint8_t typeCount{};
+    };
+
+    /// @brief Placeholder for the Extents if they are known at compile time.
+    struct NoExtents
+    {};
+
+    /// @brief Additional data needed by shape aware rules.
+    struct ShapeData
+    {
+        /// @brief The first row or column of each line, indexed by group id.
+        Buffer<std::uint8_t, TileCount + 1U> lineStarts{};
+
+        /// @brief The length of each line, indexed by group id.
+        Buffer<std::uint8_t, TileCount + 1U> lineLengths{};
+
+        /// @brief The indices of the special tiles that collapsed, but did not trigger yet.
+        Buffer<std::uint16_t, TileCount> triggers{};
+
+        /// @brief The special tiles that collapsed, indexed by their index in the grid.
+        Buffer<std::uint8_t, TileCount> triggerTiles{};
+
+        /// @brief The number of entries in triggers.
+        size_t triggerCount{};
+
+        /// @brief The index of the tile replaced by a special tile for each entry of _waveCollapses.
+        Buffer<std::uint16_t, waveCapacity(TileCount)> spawnIndices{};
+    };
+
+    /// @brief Placeholder for the ShapeData if the rules are not shape aware.
+    struct NoShapeData
+    {};
+
+    /// @brief The type of each tile, stored column by column.
+    Buffer<std::uint8_t, TileCount> _types{};
+
+    /// @brief The id of horizontal group each tile belongs to.
+    Buffer<std::uint16_t, TileCount> _horizontalGroupIds{};
+
+    /// @brief The id of vertical group each tile belongs to.
+    Buffer<std::uint16_t, TileCount> _verticalGroupIds{};
+
+    /// @brief The number of rows, counted from the top, that changed in each column since the last collapse.
+    Buffer<std::uint8_t, TWidth> _dirtyRows{};
+
+    /// @brief Maps group ids to _waveCollapses indices plus one, sized for the maximum number of groups per wave.
+    Buffer<std::uint32_t, TileCount + 1U> _groups{};
+
+    /// @brief The collapses of the current wave, including the ones merged into others.
+    Buffer<Collapse, waveCapacity(TileCount)> _waveCollapses{};
+
+    /// @brief The number of entries of _waveCollapses used by the current wave.
+    size_t _waveCount{};
+
+    /// @brief Vector of all the collapses happening during the current simulation step, grown when necessary.
+    std::vector<Collapse> _collapses{};
+
+    /// @brief The random number generator used for filling the grid.
+    Xoshiro256 _rng{};
+
+    /// @brief The Zobrist hash of the tiles, only updated if the puzzle is hashed.
+    std::uint64_t _hash{};
+
+    /// @brief The width, height and type count of the grid if they are dynamic.
+    [[no_unique_address]] std::conditional_t<IsDynamic, Extents, NoExtents> _extents{};
+
+    /// @brief Additional data needed by shape aware rules.
+    [[no_unique_address]] std::conditional_t<TRules::ShapeAware, ShapeData, NoShapeData> _shapes{};
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_BASICTILEMATCHINGPUZZLE_HPP
@@ -0,0 +1,188 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_BITBOARDTILEMATCHINGPUZZLE_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_BITBOARDTILEMATCHINGPUZZLE_HPP
+
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+#include "THzAutoGaming/utility/xoshiro256.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl>
+#include <vector>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Simulation of a tile matching puzzle using one bit-plane per tile type.
+///
+/// @remarks Produces the exact same results as TileMatchingPuzzle, so both can be used interchangeably.
+/// Runs are detected using shift-and-and operations on the bit-planes, vectorized using SSE2 or AVX2 if available.
+class BitboardTileMatchingPuzzle
+{
+public:
+    /// @brief The value of an empty tile.
+    static constexpr std::uint8_t EmptyTile{TileMatchingPuzzle::EmptyTile};
+
+    /// @brief The value of an error tile.
+    static constexpr std::uint8_t ErrorTile{TileMatchingPuzzle::ErrorTile};
+
+    /// @brief Structure containing basic information about a collapse of a line of tiles.
+    using Collapse = TileMatchingPuzzle::Collapse;
+
+    /// @brief Initializes a new simulation instance.
+    ///
+    /// @param pWidth The width of the grid.
+    /// @param pHeight The height of the grid.
+    /// @param pTypeCount The number of different tile types.
+    /// @param seed The seed of the random number generator used for filling the grid.
+    BitboardTileMatchingPuzzle(std::uint8_t const  pWidth,
+                               std::uint8_t const  pHeight,
+                               std::uint8_t const  pTypeCount,
+                               std::uint64_t const seed = Xoshiro256::DefaultSeed) noexcept;
+
+    /// @brief Returns the width of the grid.
+    ///
+    /// @return The width of the grid.
+    std::uint8_t width() const noexcept;
+
+    /// @brief Returns the height of the grid.
+    ///
+    /// @return The height of the grid.
+    std::uint8_t height() const noexcept;
+
+    /// @brief Returns the number of different tile types.
+    ///
+    /// @return The number of different tile types.
+    std::uint8_t typeCount() const noexcept;
+
+    /// @brief Provides access to the random number generator used for filling the grid.
+    ///
+    /// @return The random number generator used for filling the grid.
+    Xoshiro256 &rng() noexcept;
+
+    /// @brief Provides access to the tile at the given coordinates.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The content of the tile, 0xFF if the tile is out of range.
+    std::uint8_t operator()(std::uint8_t const x, std::uint8_t const y) const noexcept;
+
+    /// @brief Sets a new value for the tile at the given coordinates.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @param newContent The new value of the tile.
+    /// @return True if the tile was set, false otherwise.
+    bool setTile(std::uint8_t const x, std::uint8_t const y, std::uint8_t const newContent) noexcept;
+
+    /// @brief Simulates the next step in the game.
+    ///
+    /// @param refill True if the grid shall be refilled after gravity has been applied.
+    /// @return The collapses that happened during simulation.
+    /// @remarks Repeatedly collapses matching tiles and applies gravity until nothing is changed during collapse.
+    gsl::span<Collapse> simulate(bool const refill = true) noexcept;
+
+private:
+    /// @brief The type used for the words of the bit-planes.
+    using Word = std::uint64_t;
+
+    /// @brief The number of bits in a Word.
+    static constexpr std::uint32_t WordBits{64U};
+
+    /// @brief Returns the index of the given tile in _tiles.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The index of the tile.
+    size_t tileIndex(std::uint32_t const x, std::uint32_t const y) const noexcept;
+
+    /// @brief Returns the index of the word containing the given tile inside a bit-plane.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The index of the word.
+    size_t wordIndex(std::uint32_t const x, std::uint32_t const y) const noexcept;
+
+    /// @brief Returns a pointer to the first word of the bit-plane of the given type.
+    ///
+    /// @param type The type of tile [1-typeCount].
+    /// @return Pointer to the bit-plane.
+    Word *plane(std::uint8_t const type) noexcept;
+
+    /// @brief Writes the given type into the tile and its bit-plane.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @param type The new type of the tile.
+    void writeTile(std::uint32_t const x, std::uint32_t const y, std::uint8_t const type) noexcept;
+
+    /// @brief Recreates the bit-planes of the given column from _tiles.
+    ///
+    /// @param x The column to rebuild.
+    void rebuildColumn(std::uint32_t const x) noexcept;
+
+    /// @brief Marks all tiles that are part of a horizontal or vertical line of 3 or more similar tiles.
+    void findRuns() noexcept;
+
+    /// @brief Collapses all lines of similar cells that are 3 tiles or longer.
+    ///
+    /// @param wave The current wave of the simulation.
+    void collapse(std::uint16_t const wave) noexcept;
+
+    /// @brief Fills up empty cells by moving the content of other cells above into them.
+    ///
+    /// @return True if there were any changes to the grid, false otherwise.
+    bool gravity() noexcept;
+
+    /// @brief Fills empty cells with random new values.
+    ///
+    /// @return True if there were any changes to the grid, false otherwise.
+    bool fill() noexcept;
+
+    /// @brief The width of the grid.
+    std::uint8_t _width{};
+
+    /// @brief The height of the grid.
+    std::uint8_t _height{};
+
+    /// @brief The number of different tile types.
+    std::uint8_t _typeCount{};
+
+    /// @brief The number of words needed to store one column of a bit-plane.
+    std::uint32_t _wordsPerColumn{};
+
+    /// @brief The number of words needed to store one bit-plane.
+    size_t _wordsPerPlane{};
+
+    /// @brief The type of each tile, stored column by column.
+    std::vector<std::uint8_t> _tiles{};
+
+    /// @brief One bit-plane for each type of tile, stored column by column.
+    std::vector<Word> _planes{};
+
+    /// @brief Bit-plane marking all tiles that are part of a horizontal line.
+    std::vector<Word> _horizontal{};
+
+    /// @brief Bit-plane marking all tiles that are part of a vertical line.
+    std::vector<Word> _vertical{};
+
+    /// @brief Buffer for the start positions of lines during findRuns().
+    std::vector<Word> _starts{};
+
+    /// @brief The id of horizontal group each marked tile belongs to.
+    std::vector<std::uint16_t> _horizontalGroupIds{};
+
+    /// @brief The id of vertical group each marked tile belongs to.
+    std::vector<std::uint16_t> _verticalGroupIds{};
+
+    /// @brief Vector mapping group Ids to _collapses indeces.
+    std::vector<std::uint16_t> _groups{};
+
+    /// @brief Vector of all the collapses happening during the current simulation step.
+    std::vector<Collapse> _collapses{};
+
+    /// @brief The random number generator used for filling the grid.
+    Xoshiro256 _rng{};
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_BITBOARDTILEMATCHINGPUZZLE_HPP
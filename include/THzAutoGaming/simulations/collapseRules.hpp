@@ -0,0 +1,232 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_COLLAPSERULES_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_COLLAPSERULES_HPP
+
+#include "THzAutoGaming/simulations/tileMatchingTypes.hpp"
+
+#include <concepts>
+#include <cstdint>
+
+namespace Terrahertz::Simulations {
+
+// clang-format off
+
+/// @brief Concept for the rules deciding how the groups of a BasicTileMatchingPuzzle collapse.
+///
+/// @remarks Shape aware rules also need a static template method
+/// trigger(tile, x, y, width, height, typeAt, clear) applying the effect of a special tile by calling clear(x, y)
+/// for every affected tile, typeAt(x, y) returns the tile at the given position.
+template <typename TRulesType>
+concept CollapseRules = requires(std::uint8_t const tile, TileMatchingTypes::Shape const shape)
+{
+    // true if the shape of each collapse is determined and special tiles are used
+    {TRulesType::ShapeAware} -> std::convertible_to<bool>;
+
+    // the maximum number of tile types supported
+    {TRulesType::MaxTypeCount} -> std::convertible_to<std::uint8_t>;
+
+    // returns true if the given tile can be decoded by the rules
+    {TRulesType::isValid(tile)} noexcept -> std::same_as<bool>;
+
+    // returns the type used for matching the given tile with others
+    {TRulesType::matchType(tile)} noexcept -> std::same_as<std::uint8_t>;
+
+    // returns true if the given tile has an effect when collapsing
+    {TRulesType::isSpecial(tile)} noexcept -> std::same_as<bool>;
+
+    // returns the special tile created by a collapse of the given type and shape, EmptyTile for none
+    {TRulesType::spawn(tile, shape)} noexcept -> std::same_as<std::uint8_t>;
+};
+
+// clang-format on
+
+/// @brief Rules of a plain tile matching puzzle, lines collapse without any further effects.
+struct PlainRules
+{
+    /// @brief Shapes are not determined.
+    static constexpr bool ShapeAware{false};
+
+    /// @brief All tile values apart from EmptyTile and ErrorTile can be used as types.
+    static constexpr std::uint8_t MaxTypeCount{TileMatchingTypes::ErrorTile - 1U};
+
+    /// @brief Returns true if the given tile can be decoded by the rules.
+    ///
+    /// @return Always true, the type count of the puzzle limits the tiles.
+    static constexpr bool isValid(std::uint8_t const) noexcept { return true; }
+
+    /// @brief Returns the type used for matching the given tile with others.
+    ///
+    /// @param tile The tile to check.
+    /// @return The tile itself.
+    static constexpr std::uint8_t matchType(std::uint8_t const tile) noexcept { return tile; }
+
+    /// @brief Returns true if the given tile has an effect when collapsing.
+    ///
+    /// @return Always false.
+    static constexpr bool isSpecial(std::uint8_t const) noexcept { return false; }
+
+    /// @brief Returns the special tile created by a collapse.
+    ///
+    /// @return Always EmptyTile.
+    static constexpr std::uint8_t spawn(std::uint8_t const, TileMatchingTypes::Shape const) noexcept
+    {
+        return TileMatchingTypes::EmptyTile;
+    }
+};
+
+/// @brief Rules of common match-3 games, spawning special tiles for long lines and L, T or cross shapes.
+///
+/// @remarks A line of 4 creates a striped tile clearing its column, L, T and cross shapes create a bomb clearing the
+/// surrounding 3x3 tiles and a line of 5 or more creates a rainbow tile clearing all tiles of its type. The special
+/// tile takes the place of the tile of the group that determined its shape. Special tiles match with tiles of the same
+/// type and trigger their effect when they collapse, this includes being cleared by the effect of another special tile.
+struct SpecialTileRules
+{
+    /// @brief Enumeration of the special tiles.
+    enum class Special : std::uint8_t
+    {
+        /// @brief A normal tile.
+        None,
+
+        /// @brief Clears the column of the tile.
+        Striped,
+
+        /// @brief Clears the 3x3 tiles around the tile.
+        Bomb,
+
+        /// @brief Clears all tiles of the same type.
+        Rainbow
+    };
+
+    /// @brief Shapes are determined.
+    static constexpr bool ShapeAware{true};
+
+    /// @brief The bits of a tile storing its type.
+    static constexpr std::uint8_t TypeMask{0x1FU};
+
+    /// @brief The number of bits the special is shifted by inside of a tile.
+    static constexpr std::uint8_t SpecialShift{5U};
+
+    /// @brief The type of a tile is stored in the lower 5 bits, the type of the ErrorTile must not be reachable.
+    static constexpr std::uint8_t MaxTypeCount{TypeMask - 1U};
+
+    /// @brief Creates a tile of the given type and special.
+    ///
+    /// @param type The type of the tile.
+    /// @param special The special of the tile.
+    /// @return The tile.
+    static constexpr std::uint8_t makeTile(std::uint8_t const type, Special const special) noexcept
+    {
+        return static_cast<std::uint8_t>(type | (static_cast<std::uint8_t>(special) << SpecialShift));
+    }
+
+    /// @brief Returns the special of the given tile.
+    ///
+    /// @param tile The tile to check.
+    /// @return The special of the tile.
+    static constexpr Special special(std::uint8_t const tile) noexcept
+    {
+        return static_cast<Special>(tile >> SpecialShift);
+    }
+
+    /// @brief Returns true if the given tile can be decoded by the rules.
+    ///
+    /// @param tile The tile to check.
+    /// @return True if the special bits name a special and only non empty tiles have one, false otherwise.
+    static constexpr bool isValid(std::uint8_t const tile) noexcept
+    {
+        auto const empty = (tile & TypeMask) == TileMatchingTypes::EmptyTile;
+        return (special(tile) <= Special::Rainbow) && (!empty || (special(tile) == Special::None));
+    }
+
+    /// @brief Returns the type used for matching the given tile with others.
+    ///
+    /// @param tile The tile to check.
+    /// @return The type of the tile without the special.
+    static constexpr std::uint8_t matchType(std::uint8_t const tile) noexcept { return tile & TypeMask; }
+
+    /// @brief Returns true if the given tile has an effect when collapsing.
+    ///
+    /// @param tile The tile to check.
+    /// @return True if the tile is a special tile, false otherwise.
+    static constexpr bool isSpecial(std::uint8_t const tile) noexcept { return special(tile) != Special::None; }
+
+    /// @brief Returns the special tile created by a collapse of the given type and shape.
+    ///
+    /// @param type The type of the collapse.
+    /// @param shape The shape of the collapse.
+    /// @return The special tile, EmptyTile if the shape does not create one.
+    static constexpr std::uint8_t spawn(std::uint8_t const type, TileMatchingTypes::Shape const shape) noexcept
+    {
+        switch (shape)
+        {
+        case TileMatchingTypes::Shape::Line4:
+            return makeTile(type, Special::Striped);
+        case TileMatchingTypes::Shape::L:
+        case TileMatchingTypes::Shape::T:
+        case TileMatchingTypes::Shape::Cross:
+            return makeTile(type, Special::Bomb);
+        case TileMatchingTypes::Shape::Line5:
+            return makeTile(type, Special::Rainbow);
+        default:
+            return TileMatchingTypes::EmptyTile;
+        }
+    }
+
+    /// @brief Applies the effect of the given special tile.
+    ///
+    /// @tparam TTypeAt The type of the functor returning the tile at a position.
+    /// @tparam TClear The type of the functor clearing the tile at a position.
+    /// @param tile The special tile that collapsed.
+    /// @param x The row of the special tile.
+    /// @param y The column of the special tile.
+    /// @param width The width of the grid.
+    /// @param height The height of the grid.
+    /// @param typeAt The functor returning the tile at a position.
+    /// @param clear The functor clearing the tile at a position.
+    template <typename TTypeAt, typename TClear>
+    static void trigger(std::uint8_t const  tile,
+                        std::uint32_t const x,
+                        std::uint32_t const y,
+                        std::uint32_t const width,
+                        std::uint32_t const height,
+                        TTypeAt const      &typeAt,
+                        TClear const       &clear) noexcept
+    {
+        switch (special(tile))
+        {
+        case Special::Striped:
+            for (auto ty = 0U; ty < height; ++ty)
+            {
+                clear(x, ty);
+            }
+            break;
+        case Special::Bomb:
+            for (auto tx = (x > 0U) ? (x - 1U) : 0U; (tx <= (x + 1U)) && (tx < width); ++tx)
+            {
+                for (auto ty = (y > 0U) ? (y - 1U) : 0U; (ty <= (y + 1U)) && (ty < height); ++ty)
+                {
+                    clear(tx, ty);
+                }
+            }
+            break;
+        case Special::Rainbow:
+            for (auto tx = 0U; tx < width; ++tx)
+            {
+                for (auto ty = 0U; ty < height; ++ty)
+                {
+                    if (matchType(typeAt(tx, ty)) == matchType(tile))
+                    {
+                        clear(tx, ty);
+                    }
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_COLLAPSERULES_HPP
@@ -0,0 +1,121 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_MOVEEVALUATOR_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_MOVEEVALUATOR_HPP
+
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+#include "THzAutoGaming/utility/threadPool.hpp"
+
+#include <cstdint>
+#include <gsl/gsl>
+#include <optional>
+#include <vector>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Evaluates the legal moves of a TileMatchingPuzzle using random refill rollouts on multiple threads.
+class MoveEvaluator
+{
+public:
+    /// @brief Function calculating the score of a single collapse.
+    using ScoreFunction = double (*)(TileMatchingPuzzle::Collapse const &collapse) noexcept;
+
+    /// @brief Structure containing the aggregated results of all rollouts of a single move.
+    struct Statistics
+    {
+        /// @brief The move the statistics belong to.
+        TileMatchingPuzzle::Move move{};
+
+        /// @brief The number of rollouts performed for the move.
+        std::uint32_t rollouts{};
+
+        /// @brief The mean score of the rollouts.
+        double meanScore{};
+
+        /// @brief The variance of the score of the rollouts.
+        double scoreVariance{};
+
+        /// @brief The mean number of collapsed tiles of the rollouts.
+        double meanAmount{};
+
+        /// @brief The mean number of waves of the rollouts.
+        double meanWaves{};
+    };
+
+    /// @brief The default score function, scoring each collapsed tile with one point.
+    ///
+    /// @param collapse The collapse to score.
+    /// @return The score of the collapse.
+    static double defaultScore(TileMatchingPuzzle::Collapse const &collapse) noexcept;
+
+    /// @brief Initializes a new MoveEvaluator.
+    ///
+    /// @param threadCount The number of threads used for the rollouts, 0 to use one thread per hardware thread.
+    /// @param score The function used to score the collapses of each rollout.
+    MoveEvaluator(std::uint32_t const threadCount = 0U, ScoreFunction const score = defaultScore) noexcept;
+
+    /// @brief Returns the number of threads used for the rollouts.
+    ///
+    /// @return The number of threads used for the rollouts.
+    std::uint32_t threadCount() const noexcept;
+
+    /// @brief Evaluates all legal moves of the given puzzle.
+    ///
+    /// @param puzzle The puzzle to evaluate.
+    /// @param rollouts The number of rollouts per move.
+    /// @param seed The seed for the random refill of the rollouts.
+    /// @return The statistics of each legal move, valid until the next call.
+    /// @remarks Each rollout is seeded individually, so the results do not depend on the number of threads.
+    gsl::span<Statistics const>
+    evaluate(TileMatchingPuzzle const &puzzle, std::uint32_t const rollouts, std::uint64_t const seed = 0U) noexcept;
+
+private:
+    /// @brief Structure accumulating the results of the rollouts of a single move.
+    struct Accumulator
+    {
+        /// @brief The sum of the scores.
+        double score{};
+
+        /// @brief The sum of the squared scores.
+        double scoreSquared{};
+
+        /// @brief The sum of the collapsed tiles.
+        double amount{};
+
+        /// @brief The sum of the waves.
+        double waves{};
+
+        /// @brief The number of rollouts.
+        std::uint32_t rollouts{};
+    };
+
+    /// @brief Structure containing the data owned by a single thread.
+    struct alignas(64) Worker
+    {
+        /// @brief The accumulators of the thread, one per move.
+        std::vector<Accumulator> accumulators{};
+
+        /// @brief The copy of the puzzle the rollouts are performed on, kept so it is only allocated once.
+        std::optional<TileMatchingPuzzle> clone{};
+
+        /// @brief The state of the puzzle evaluated, kept so it is only allocated once.
+        TileMatchingPuzzle::State state{};
+    };
+
+    /// @brief The function used to score the collapses.
+    ScoreFunction _score;
+
+    /// @brief The threads performing the rollouts.
+    ThreadPool _pool;
+
+    /// @brief The data owned by each thread.
+    std::vector<Worker> _workers{};
+
+    /// @brief The legal moves of the puzzle currently evaluated.
+    std::vector<TileMatchingPuzzle::Move> _moves{};
+
+    /// @brief The statistics of the last evaluation.
+    std::vector<Statistics> _statistics{};
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_MOVEEVALUATOR_HPP
@@ -0,0 +1,205 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGPUZZLEBATCH_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGPUZZLEBATCH_HPP
+
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+#include "THzAutoGaming/utility/xoshiro256.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl>
+#include <vector>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Simulation of many independent tile matching puzzles of the same size in lock-step.
+///
+/// @remarks The boards are stored as structure of arrays, the tiles at the same position of all boards are stored
+/// next to each other. This allows detecting lines and applying gravity for many boards at once using SSE2 or AVX2.
+/// Each board has its own random number generator, so every board behaves exactly like a TileMatchingPuzzle.
+class TileMatchingPuzzleBatch
+{
+public:
+    /// @brief The value of an empty tile.
+    static constexpr std::uint8_t EmptyTile{TileMatchingPuzzle::EmptyTile};
+
+    /// @brief The value of an error tile.
+    static constexpr std::uint8_t ErrorTile{TileMatchingPuzzle::ErrorTile};
+
+    /// @brief Structure describing the swap of a tile with its right or lower neighbour.
+    using Move = TileMatchingPuzzle::Move;
+
+    /// @brief Compact copy of the grid and random number generator of a single board.
+    using State = TileMatchingPuzzle::State;
+
+    /// @brief Structure summarizing the collapses of a single board during simulation.
+    struct Summary
+    {
+        /// @brief The number of tiles that collapsed.
+        std::uint32_t amount{};
+
+        /// @brief The number of waves in which tiles collapsed.
+        std::uint16_t waves{};
+    };
+
+    /// @brief Initializes a new batch of empty boards.
+    ///
+    /// @param pWidth The width of the grids.
+    /// @param pHeight The height of the grids.
+    /// @param pTypeCount The number of different tile types.
+    /// @param pBoardCount The number of boards in the batch.
+    TileMatchingPuzzleBatch(std::uint8_t const  pWidth,
+                            std::uint8_t const  pHeight,
+                            std::uint8_t const  pTypeCount,
+                            std::uint32_t const pBoardCount) noexcept;
+
+    /// @brief Returns the width of the grids.
+    ///
+    /// @return The width of the grids.
+    std::uint8_t width() const noexcept;
+
+    /// @brief Returns the height of the grids.
+    ///
+    /// @return The height of the grids.
+    std::uint8_t height() const noexcept;
+
+    /// @brief Returns the number of different tile types.
+    ///
+    /// @return The number of different tile types.
+    std::uint8_t typeCount() const noexcept;
+
+    /// @brief Returns the number of boards in the batch.
+    ///
+    /// @return The number of boards in the batch.
+    std::uint32_t boardCount() const noexcept;
+
+    /// @brief Provides access to the random number generator used for filling the given board.
+    ///
+    /// @param board The index of the board [0-boardCount).
+    /// @return The random number generator of the board.
+    /// @remarks The board index is not checked.
+    Xoshiro256 &rng(std::uint32_t const board) noexcept;
+
+    /// @brief Provides access to the tile at the given coordinates of the given board.
+    ///
+    /// @param board The index of the board [0-boardCount).
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The content of the tile, 0xFF if the board or tile is out of range.
+    std::uint8_t operator()(std::uint32_t const board, std::uint8_t const x, std::uint8_t const y) const noexcept;
+
+    /// @brief Sets a new value for the tile at the given coordinates of the given board.
+    ///
+    /// @param board The index of the board [0-boardCount).
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @param newContent The new value of the tile.
+    /// @return True if the tile was set, false otherwise.
+    bool setTile(std::uint32_t const board,
+                 std::uint8_t const  x,
+                 std::uint8_t const  y,
+                 std::uint8_t const  newContent) noexcept;
+
+    /// @brief Swaps the tiles affected by the given move on the given board.
+    ///
+    /// @param board The index of the board [0-boardCount).
+    /// @param move The move to perform.
+    /// @return True if the tiles were swapped, false if the board or move is out of range.
+    bool swapTiles(std::uint32_t const board, Move const &move) noexcept;
+
+    /// @brief Stores the grid and random number generator state of the given board in the given state.
+    ///
+    /// @param board The index of the board [0-boardCount).
+    /// @param state The state to write to.
+    /// @return True if the state was written, false if the board is out of range.
+    bool snapshot(std::uint32_t const board, State &state) const noexcept;
+
+    /// @brief Restores the grid and random number generator of the given board from the given state.
+    ///
+    /// @param board The index of the board [0-boardCount).
+    /// @param state The state to restore, e.g. taken from a TileMatchingPuzzle of the same size.
+    /// @return True if the state was restored, false if the board is out of range or the state does not fit.
+    bool restore(std::uint32_t const board, State const &state) noexcept;
+
+    /// @brief Restores the grids and random number generators of all boards from the given state.
+    ///
+    /// @param state The state to restore, e.g. taken from a TileMatchingPuzzle of the same size.
+    /// @return True if the state was restored, false if the state does not fit.
+    /// @remarks Faster than restoring each board on its own, the boards are usually reseeded afterwards.
+    bool restore(State const &state) noexcept;
+
+    /// @brief Simulates the next step in the game on all boards.
+    ///
+    /// @param refill True if the grids shall be refilled after gravity has been applied.
+    /// @return The summary of the collapses of each board, valid until the next call.
+    /// @remarks Repeatedly collapses matching tiles and applies gravity until nothing is changed on any board.
+    gsl::span<Summary const> simulate(bool const refill = true) noexcept;
+
+private:
+    /// @brief Returns the index of the given tile of the first board.
+    ///
+    /// @param x The row in the grid [left-right].
+    /// @param y The column in the grid [top-bottom].
+    /// @return The index of the tile.
+    size_t tileIndex(std::uint32_t const x, std::uint32_t const y) const noexcept;
+
+    /// @brief Checks if the given state was taken from a grid of the same width and height.
+    ///
+    /// @param state The state to check.
+    /// @return True if the state can be restored, false otherwise.
+    bool fits(State const &state) const noexcept;
+
+    /// @brief Removes all lines of similar cells that are 3 tiles or longer and adds them to the summaries.
+    ///
+    /// @param fullScan True if the entire grids shall be checked, false to only check the region around changed tiles.
+    void collapse(bool const fullScan) noexcept;
+
+    /// @brief Fills up empty cells by moving the content of other cells above into them.
+    ///
+    /// @return True if there were any changes to the grids, false otherwise.
+    bool gravity() noexcept;
+
+    /// @brief Fills empty cells with random new values.
+    ///
+    /// @return True if there were any changes to the grids, false otherwise.
+    bool fill() noexcept;
+
+    /// @brief The width of the grids.
+    std::uint8_t _width{};
+
+    /// @brief The height of the grids.
+    std::uint8_t _height{};
+
+    /// @brief The number of different tile types.
+    std::uint8_t _typeCount{};
+
+    /// @brief The number of boards in the batch.
+    std::uint32_t _boardCount{};
+
+    /// @brief The type of each tile, stored tile by tile with the boards as innermost dimension.
+    std::vector<std::uint8_t> _tiles{};
+
+    /// @brief Marks of the tiles being part of a line, same layout as _tiles.
+    std::vector<std::uint8_t> _marks{};
+
+    /// @brief The number of rows, counted from the top, changed on any board in each column since the last collapse.
+    std::vector<std::uint8_t> _dirtyRows{};
+
+    /// @brief The number of rows, counted from the top, that may contain empty tiles in each column after collapse.
+    std::vector<std::uint8_t> _emptyRows{};
+
+    /// @brief The number of rows, counted from the top, containing marked tiles in each column during collapse.
+    std::vector<std::uint8_t> _markedRows{};
+
+    /// @brief The number of tiles collapsed on each board during the current wave.
+    std::vector<std::uint16_t> _waveAmounts{};
+
+    /// @brief The random number generator of each board.
+    std::vector<Xoshiro256> _rngs{};
+
+    /// @brief The summary of each board for the current simulation step.
+    std::vector<Summary> _summaries{};
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGPUZZLEBATCH_HPP
@@ -0,0 +1,200 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGSOLVER_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGSOLVER_HPP
+
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+#include "THzAutoGaming/simulations/transpositionCache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Searches the best move of a TileMatchingPuzzle using depth-limited expectimax over swap moves.
+///
+/// @remarks The search deepens iteratively and can be interrupted at any time, best() always returns the result of the
+/// deepest completed iteration. The refill after each move is a chance node, sampled using random number generators
+/// seeded from the hash of the grid, so the value of a grid only depends on the grid and the search depth. This allows
+/// keeping the evaluated grids in a transposition table that is reused between searches, e.g. the searches of
+/// consecutive frames, and by grids reached using different move orders.
+class TileMatchingSolver
+{
+public:
+    /// @brief Function calculating the score of a single collapse.
+    using ScoreFunction = double (*)(TileMatchingPuzzle::Collapse const &collapse) noexcept;
+
+    /// @brief Structure containing the parameters of the search.
+    struct Parameters
+    {
+        /// @brief The maximum number of moves searched ahead, at most 254.
+        std::uint32_t maxDepth{4U};
+
+        /// @brief The number of refills sampled at each chance node.
+        std::uint32_t chanceSamples{4U};
+
+        /// @brief The number of entries of the transposition table, rounded up to the next power of two.
+        std::uint32_t tableSize{1U << 16U};
+
+        /// @brief The seed mixed into the sampling of the refills.
+        std::uint64_t seed{};
+
+        /// @brief The function used to score the collapses of each move.
+        ScoreFunction score{defaultScore};
+    };
+
+    /// @brief Structure containing the result of the search.
+    struct Result
+    {
+        /// @brief The best move found.
+        TileMatchingPuzzle::Move move{};
+
+        /// @brief The expected score of the best move.
+        double value{};
+
+        /// @brief The number of moves searched ahead to find the best move, 0 if no search was completed yet.
+        std::uint32_t depth{};
+
+        /// @brief The number of moves simulated since the root was set.
+        size_t nodes{};
+
+        /// @brief True if the puzzle has a legal move, false otherwise.
+        bool valid{};
+    };
+
+    /// @brief The default score function, scoring each collapsed tile with one point.
+    ///
+    /// @param collapse The collapse to score.
+    /// @return The score of the collapse.
+    static double defaultScore(TileMatchingPuzzle::Collapse const &collapse) noexcept;
+
+    /// @brief Initializes a new TileMatchingSolver using the default parameters.
+    TileMatchingSolver() noexcept;
+
+    /// @brief Initializes a new TileMatchingSolver.
+    ///
+    /// @param parameters The parameters of the search.
+    TileMatchingSolver(Parameters const &parameters) noexcept;
+
+    /// @brief Sets the puzzle to search the best move for.
+    ///
+    /// @param puzzle The puzzle to search.
+    /// @remarks Restarts the iterative deepening, the transposition table is kept so work of previous searches is
+    /// reused. The puzzle is copied, so it can be changed while the search continues.
+    void setRoot(TileMatchingPuzzle const &puzzle) noexcept;
+
+    /// @brief Continues the iterative deepening until a budget is used up or the maximum depth is reached.
+    ///
+    /// @param budget The time the search may take.
+    /// @param nodes The number of moves the search may simulate.
+    /// @return True if the maximum depth was reached, false if the search was interrupted.
+    /// @remarks An interrupted iteration is continued by the next call. The root moves it completed are skipped and
+    /// the grids it completed are looked up in the transposition table instead of being searched again. Each call
+    /// completes at least one root move or grid before it can be interrupted, so repeated calls with a budget shorter
+    /// than an iteration still reach the maximum depth, at the price of exceeding such a budget.
+    bool search(std::chrono::nanoseconds const budget,
+                size_t const             nodes = std::numeric_limits<size_t>::max()) noexcept;
+
+    /// @brief Sets the root and searches until the budget is used up or the maximum depth is reached.
+    ///
+    /// @param puzzle The puzzle to search.
+    /// @param budget The time the search may take.
+    /// @return The best move found.
+    Result const &solve(TileMatchingPuzzle const &puzzle, std::chrono::nanoseconds const budget) noexcept;
+
+    /// @brief Returns the best move found so far.
+    ///
+    /// @return The result of the deepest completed iteration.
+    Result const &best() const noexcept;
+
+    /// @brief Clears the transposition table.
+    void clear() noexcept;
+
+private:
+    /// @brief Structure containing an evaluated grid, packed to fit into a slot of the transposition table.
+    struct Entry
+    {
+        /// @brief The expected score of the grid.
+        float value{};
+
+        /// @brief The number of moves searched ahead to determine the value.
+        std::uint8_t depth{};
+
+        /// @brief The best move of the grid.
+        TileMatchingPuzzle::Move move{};
+    };
+
+    /// @brief Structure containing the buffers used at a single ply of the search.
+    struct Ply
+    {
+        /// @brief The grid of the node, refilled using snapshot() so it is only allocated once.
+        TileMatchingPuzzle::State state{};
+
+        /// @brief The hash of the grid of the node.
+        std::uint64_t key{};
+
+        /// @brief The legal moves of the grid.
+        std::vector<TileMatchingPuzzle::Move> moves{};
+    };
+
+    /// @brief Determines the expected score of the grid of the given ply.
+    ///
+    /// @param ply The ply of the grid.
+    /// @param depth The number of moves to search ahead.
+    /// @param move Set to the best move of the grid.
+    /// @return The expected score, undefined if the search was interrupted.
+    double expand(std::uint32_t const ply, std::uint32_t const depth, TileMatchingPuzzle::Move &move) noexcept;
+
+    /// @brief Checks if a budget of the current search is used up.
+    ///
+    /// @return True if the search shall be interrupted, false otherwise.
+    bool interrupted() noexcept;
+
+    /// @brief Stores the given value of the given grid in the transposition table.
+    ///
+    /// @param key The hash of the grid.
+    /// @param entry The value of the grid.
+    void store(std::uint64_t const key, Entry const &entry) noexcept;
+
+    /// @brief The parameters of the search.
+    Parameters _parameters{};
+
+    /// @brief The transposition table, keyed by the hash of the grid.
+    TranspositionCache<Entry> _table;
+
+    /// @brief The buffers of each ply.
+    std::vector<Ply> _plies{};
+
+    /// @brief The copy of the puzzle used to simulate the moves.
+    std::optional<TileMatchingPuzzle> _puzzle{};
+
+    /// @brief The result of the deepest completed iteration.
+    Result _best{};
+
+    /// @brief The index of the first root move not completed by the current iteration.
+    size_t _rootNext{};
+
+    /// @brief The best value of the root moves completed by the current iteration.
+    double _rootValue{};
+
+    /// @brief The best of the root moves completed by the current iteration.
+    TileMatchingPuzzle::Move _rootMove{};
+
+    /// @brief The deadline of the current search.
+    std::chrono::steady_clock::time_point _deadline{};
+
+    /// @brief The number of simulated moves after which the current search is interrupted.
+    size_t _nodeLimit{};
+
+    /// @brief True if the current search completed a root move or grid, false otherwise.
+    bool _progress{};
+
+    /// @brief True if a budget of the current search is used up.
+    bool _interrupted{};
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGSOLVER_HPP
@@ -0,0 +1,88 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGTYPES_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGTYPES_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Constants and types shared by all tile matching puzzles.
+struct TileMatchingTypes
+{
+    /// @brief The value of an empty tile.
+    static constexpr std::uint8_t EmptyTile{0x00U};
+
+    /// @brief The value of an error tile.
+    static constexpr std::uint8_t ErrorTile{0xFFU};
+
+    /// @brief Enumeration of the shapes of collapsing groups of tiles, ordered by strength.
+    enum class Shape : std::uint8_t
+    {
+        /// @brief The shape was not determined.
+        Unknown,
+
+        /// @brief A line of 3 tiles.
+        Line3,
+
+        /// @brief A line of 4 tiles.
+        Line4,
+
+        /// @brief Two lines meeting at their ends.
+        L,
+
+        /// @brief A line ending in the middle of another line.
+        T,
+
+        /// @brief Two lines crossing each other in their middle.
+        Cross,
+
+        /// @brief A line of 5 or more tiles.
+        Line5,
+
+        /// @brief Tiles cleared by the effect of a special tile instead of a line.
+        Effect
+    };
+
+    /// @brief Structure containing basic information about a collapse of a line of tiles.
+    struct Collapse
+    {
+        /// @brief The number of the type of tile.
+        std::uint8_t type{};
+
+        /// @brief The shape of the collapse, only determined by puzzles using shape aware rules.
+        Shape shape{};
+
+        /// @brief The amount of tiles that collapsed.
+        std::uint16_t amount{};
+
+        /// @brief The wave of the simulation in which the collapse took place.
+        std::uint16_t wave{};
+    };
+
+    /// @brief Structure describing the swap of a tile with its right or lower neighbour.
+    struct Move
+    {
+        /// @brief The row of the tile to swap [left-right].
+        std::uint8_t x{};
+
+        /// @brief The column of the tile to swap [top-bottom].
+        std::uint8_t y{};
+
+        /// @brief True if the tile is swapped with the tile below, false if swapped with the tile to the right.
+        bool vertical{};
+    };
+
+    /// @brief Structure describing the outcome of a simulation writing to a caller supplied buffer.
+    struct SimulationResult
+    {
+        /// @brief The number of collapses written to the buffer.
+        size_t count{};
+
+        /// @brief True if the buffer was too small to hold all collapses.
+        bool overflow{};
+    };
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_TILEMATCHINGTYPES_HPP
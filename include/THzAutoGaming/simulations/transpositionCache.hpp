@@ -0,0 +1,137 @@
+#ifndef THZ_AUTOGAMING_SIMULATIONS_TRANSPOSITIONCACHE_HPP
+#define THZ_AUTOGAMING_SIMULATIONS_TRANSPOSITIONCACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace Terrahertz::Simulations {
+
+/// @brief Structure describing the outcome of simulating a grid, small enough to be stored in a TranspositionCache.
+struct CollapseOutcome
+{
+    /// @brief The number of tiles that collapsed.
+    std::uint32_t amount{};
+
+    /// @brief The number of waves in which tiles collapsed.
+    std::uint16_t waves{};
+
+    /// @brief The number of collapses.
+    std::uint16_t collapses{};
+};
+
+// clang-format off
+
+/// @brief Concept of a value that can be stored in a TranspositionCache.
+template <typename TValueType>
+concept CacheValue = std::is_trivially_copyable_v<TValueType> && (sizeof(TValueType) == sizeof(std::uint64_t));
+
+// clang-format on
+
+/// @brief Lock-free cache of fixed size mapping hashes of grids, e.g. TileMatchingPuzzle::hash(), to values.
+///
+/// @tparam TValue The type of the stored values.
+/// @remarks Each slot stores the value and the key xor'ed with the value, both as relaxed atomics. A reader only
+/// accepts a slot if both words match the key, so slots torn by concurrent writes are treated as misses instead of
+/// returning a value of another grid. Slots are always replaced, colliding keys simply evict each other. The key ~0 is
+/// never stored, as it would match empty slots.
+///
+/// The key has to cover everything the value depends on. TileMatchingPuzzle::hash() covers the tiles, grid size and
+/// type count but not the random number generator, so it is only a complete key for values that do not depend on the
+/// refill, e.g. the outcome of simulate(false), or for values whose refills are seeded from the hash itself.
+template <CacheValue TValue = CollapseOutcome>
+class TranspositionCache
+{
+public:
+    /// @brief Initializes a new cache.
+    ///
+    /// @param pSize The number of slots, rounded up to the next power of two.
+    TranspositionCache(size_t const pSize) noexcept
+        : _mask{std::bit_ceil(std::max<size_t>(pSize, 1U)) - 1U}, _slots{std::make_unique<Slot[]>(_mask + 1U)}
+    {}
+
+    /// @brief Returns the number of slots of the cache.
+    ///
+    /// @return The number of slots.
+    size_t size() const noexcept { return _mask + 1U; }
+
+    /// @brief Looks up the value stored for the given key.
+    ///
+    /// @param key The key to look up.
+    /// @param value Set to the stored value if the key was found.
+    /// @return True if the key was found, false otherwise.
+    /// @remarks Safe to call concurrently with lookup() and store() from other threads.
+    bool lookup(std::uint64_t const key, TValue &value) const noexcept
+    {
+        if (key == InvalidKey)
+        {
+            return false;
+        }
+        auto const &slot  = _slots[key & _mask];
+        auto const  data  = slot.data.load(std::memory_order_relaxed);
+        auto const  check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key)
+        {
+            return false;
+        }
+        value = std::bit_cast<TValue>(data);
+        return true;
+    }
+
+    /// @brief Stores the given value for the given key, replacing the previous content of its slot.
+    ///
+    /// @param key The key of the value.
+    /// @param value The value to store.
+    /// @remarks Safe to call concurrently with lookup() and store() from other threads. Does nothing for the key ~0.
+    void store(std::uint64_t const key, TValue const &value) noexcept
+    {
+        if (key == InvalidKey)
+        {
+            return;
+        }
+        auto      &slot = _slots[key & _mask];
+        auto const data = std::bit_cast<std::uint64_t>(value);
+        slot.data.store(data, std::memory_order_relaxed);
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+    /// @brief Removes all values from the cache.
+    ///
+    /// @remarks Must not be called concurrently with other methods.
+    void clear() noexcept
+    {
+        for (auto i = 0U; i <= _mask; ++i)
+        {
+            _slots[i].data.store(0U, std::memory_order_relaxed);
+            _slots[i].check.store(InvalidKey, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    /// @brief The key matched by empty slots, which is therefore never stored.
+    static constexpr std::uint64_t InvalidKey{~std::uint64_t{}};
+
+    /// @brief Structure containing a single slot of the cache.
+    struct Slot
+    {
+        /// @brief The stored value.
+        std::atomic<std::uint64_t> data{};
+
+        /// @brief The key xor'ed with the stored value, empty slots only match the invalid key.
+        std::atomic<std::uint64_t> check{InvalidKey};
+    };
+
+    /// @brief The mask applied to keys to determine their slot.
+    size_t _mask{};
+
+    /// @brief The slots of the cache.
+    std::unique_ptr<Slot[]> _slots{};
+};
+
+} // namespace Terrahertz::Simulations
+
+#endif // !THZ_AUTOGAMING_SIMULATIONS_TRANSPOSITIONCACHE_HPP
@@ -0,0 +1,72 @@
+#ifndef THZ_AUTOGAMING_UTILITY_THREADPOOL_HPP
+#define THZ_AUTOGAMING_UTILITY_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz {
+
+/// @brief Set of persistent threads running the same task in parallel.
+class ThreadPool
+{
+public:
+    /// @brief Initializes a new ThreadPool.
+    ///
+    /// @param threadCount The number of threads in the pool, 0 to use one thread per hardware thread.
+    ThreadPool(std::uint32_t const threadCount = 0U) noexcept;
+
+    /// @brief Finalizes this ThreadPool instance, joining all threads.
+    ~ThreadPool() noexcept;
+
+    ThreadPool(ThreadPool const &)            = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    /// @brief Returns the number of threads in the pool.
+    ///
+    /// @return The number of threads in the pool.
+    std::uint32_t threadCount() const noexcept;
+
+    /// @brief Runs the given task once on every thread of the pool and waits until all of them finished.
+    ///
+    /// @param task The task to run, receiving the index of the thread it is executed on.
+    /// @remarks The task must not call run() on the same pool.
+    void run(std::function<void(std::uint32_t)> const &task) noexcept;
+
+private:
+    /// @brief The method executed by each thread of the pool.
+    ///
+    /// @param index The index of the thread.
+    void threadMethod(std::uint32_t const index) noexcept;
+
+    /// @brief Mutex protecting the members below.
+    std::mutex _mutex{};
+
+    /// @brief Used to wake up the threads when a new task is available.
+    std::condition_variable _wakeUp{};
+
+    /// @brief Used to signal run() that all threads finished the task.
+    std::condition_variable _done{};
+
+    /// @brief The task currently executed by the threads.
+    std::function<void(std::uint32_t)> const *_task{};
+
+    /// @brief Incremented each time a new task is started.
+    std::uint64_t _round{};
+
+    /// @brief The number of threads still working on the current task.
+    std::uint32_t _busy{};
+
+    /// @brief Flag signalling the threads to shut down.
+    bool _shutdown{};
+
+    /// @brief The threads of the pool.
+    std::vector<std::thread> _threads{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_AUTOGAMING_UTILITY_THREADPOOL_HPP
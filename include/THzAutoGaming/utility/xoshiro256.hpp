@@ -0,0 +1,163 @@
+#ifndef THZ_AUTOGAMING_UTILITY_XOSHIRO256_HPP
+#define THZ_AUTOGAMING_UTILITY_XOSHIRO256_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace Terrahertz {
+
+/// @brief Fast, seedable and splittable random number generator implementing xoshiro256**.
+///
+/// @remarks Satisfies the UniformRandomBitGenerator requirements, so it can be used with the std distributions.
+class Xoshiro256
+{
+public:
+    /// @brief The type of the generated numbers.
+    using result_type = std::uint64_t;
+
+    /// @brief The type of the internal state.
+    using StateType = std::array<std::uint64_t, 4U>;
+
+    /// @brief The seed used if none is given.
+    static constexpr std::uint64_t DefaultSeed{0x5EEDU};
+
+    /// @brief Returns the smallest value the generator can return.
+    ///
+    /// @return The smallest value the generator can return.
+    static constexpr result_type min() noexcept { return std::numeric_limits<result_type>::min(); }
+
+    /// @brief Returns the largest value the generator can return.
+    ///
+    /// @return The largest value the generator can return.
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    /// @brief Initializes a new generator from the given seed.
+    ///
+    /// @param seed The seed to expand into the state of the generator.
+    constexpr Xoshiro256(std::uint64_t const seed = DefaultSeed) noexcept { this->seed(seed); }
+
+    /// @brief Initializes a new generator using the given state.
+    ///
+    /// @param state The state of the generator, must not be all zero.
+    constexpr Xoshiro256(StateType const &state) noexcept : _state{state} {}
+
+    /// @brief Resets the generator using the given seed.
+    ///
+    /// @param seed The seed to expand into the state of the generator.
+    constexpr void seed(std::uint64_t seed) noexcept
+    {
+        // splitmix64 is used to expand the seed, this makes sure the state is never all zero
+        for (auto &word : _state)
+        {
+            seed += 0x9E3779B97F4A7C15ULL;
+            auto z = seed;
+            z      = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            z      = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+            word   = z ^ (z >> 31U);
+        }
+    }
+
+    /// @brief Returns the current state of the generator.
+    ///
+    /// @return The current state of the generator.
+    constexpr StateType const &state() const noexcept { return _state; }
+
+    /// @brief Generates the next random number.
+    ///
+    /// @return The next random number.
+    constexpr result_type operator()() noexcept
+    {
+        auto const result = rotl(_state[1U] * 5U, 7U) * 9U;
+        auto const t      = _state[1U] << 17U;
+        _state[2U] ^= _state[0U];
+        _state[3U] ^= _state[1U];
+        _state[1U] ^= _state[2U];
+        _state[0U] ^= _state[3U];
+        _state[2U] ^= t;
+        _state[3U] = rotl(_state[3U], 45U);
+        return result;
+    }
+
+    /// @brief Generates a random number in the range [0, range).
+    ///
+    /// @param range The upper bound of the range, must not be zero.
+    /// @return The random number.
+    /// @remarks Uses the multiply-shift method, avoiding the division of the std distributions in most cases.
+    constexpr std::uint32_t bounded(std::uint32_t const range) noexcept
+    {
+        auto product = static_cast<std::uint64_t>(static_cast<std::uint32_t>((*this)() >> 32U)) * range;
+        auto low     = static_cast<std::uint32_t>(product);
+        if (low < range)
+        {
+            auto const threshold = static_cast<std::uint32_t>(-range) % range;
+            while (low < threshold)
+            {
+                product = static_cast<std::uint64_t>(static_cast<std::uint32_t>((*this)() >> 32U)) * range;
+                low     = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32U);
+    }
+
+    /// @brief Advances the generator by 2^128 steps.
+    ///
+    /// @remarks Can be used to create 2^128 non-overlapping streams from a single seed.
+    constexpr void jump() noexcept
+    {
+        constexpr std::array<std::uint64_t, 4U> JumpPolynomial{
+            0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+
+        StateType result{};
+        for (auto const polynomial : JumpPolynomial)
+        {
+            for (auto bit = 0U; bit < 64U; ++bit)
+            {
+                if ((polynomial & (std::uint64_t{1U} << bit)) != 0U)
+                {
+                    for (auto i = 0U; i < result.size(); ++i)
+                    {
+                        result[i] ^= _state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        _state = result;
+    }
+
+    /// @brief Splits off a new generator, whose stream does not overlap with the one of this generator.
+    ///
+    /// @return The new generator, continuing where this generator was before the call.
+    /// @remarks This generator jumps ahead 2^128 steps.
+    constexpr Xoshiro256 split() noexcept
+    {
+        auto const child = *this;
+        jump();
+        return child;
+    }
+
+    /// @brief Checks if both generators are in the same state.
+    ///
+    /// @param other The generator to compare to.
+    /// @return True if both generators will produce the same sequence, false otherwise.
+    constexpr bool operator==(Xoshiro256 const &other) const noexcept = default;
+
+private:
+    /// @brief Rotates the given value left.
+    ///
+    /// @param value The value to rotate.
+    /// @param shift The number of bits to rotate by.
+    /// @return The rotated value.
+    static constexpr std::uint64_t rotl(std::uint64_t const value, std::uint32_t const shift) noexcept
+    {
+        return (value << shift) | (value >> (64U - shift));
+    }
+
+    /// @brief The state of the generator.
+    StateType _state{};
+};
+
+} // namespace Terrahertz
+
+#endif // !THZ_AUTOGAMING_UTILITY_XOSHIRO256_HPP
@@ -0,0 +1,182 @@
+#include "THzAutoGaming/optimisation/evolution/statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Terrahertz::Optimisation::Evolution {
+namespace {
+
+/// @brief Wrapper of a number written to a JSON object.
+struct JsonNumber
+{
+    /// @brief The number to write.
+    double value{};
+};
+
+/// @brief Writes the given number, non-finite numbers are written as null as JSON can not represent them.
+///
+/// @param stream The stream to write to.
+/// @param number The number to write.
+/// @return The stream.
+std::ostream &operator<<(std::ostream &stream, JsonNumber const number)
+{
+    return std::isfinite(number.value) ? (stream << number.value) : (stream << "null");
+}
+
+} // namespace
+
+FitnessSummary summarizeFitness(double const *fitness, size_t const count) noexcept
+{
+    FitnessSummary summary{fitness[0U], fitness[0U], 0.0, 0.0};
+
+    // the first pass determines the range and the sum
+    size_t i{};
+#if defined(__AVX2__)
+    if (count >= 4U)
+    {
+        auto vMin = _mm256_loadu_pd(fitness);
+        auto vMax = vMin;
+        auto vSum = _mm256_setzero_pd();
+        for (; (i + 4U) <= count; i += 4U)
+        {
+            auto const v = _mm256_loadu_pd(fitness + i);
+            vMin         = _mm256_min_pd(vMin, v);
+            vMax         = _mm256_max_pd(vMax, v);
+            vSum         = _mm256_add_pd(vSum, v);
+        }
+        alignas(32) double lanes[3U][4U];
+        _mm256_store_pd(lanes[0U], vMin);
+        _mm256_store_pd(lanes[1U], vMax);
+        _mm256_store_pd(lanes[2U], vSum);
+        for (auto lane = 0U; lane < 4U; ++lane)
+        {
+            summary.min = std::min(summary.min, lanes[0U][lane]);
+            summary.max = std::max(summary.max, lanes[1U][lane]);
+            summary.sum += lanes[2U][lane];
+        }
+    }
+#elif defined(__SSE2__)
+    if (count >= 2U)
+    {
+        auto vMin = _mm_loadu_pd(fitness);
+        auto vMax = vMin;
+        auto vSum = _mm_setzero_pd();
+        for (; (i + 2U) <= count; i += 2U)
+        {
+            auto const v = _mm_loadu_pd(fitness + i);
+            vMin         = _mm_min_pd(vMin, v);
+            vMax         = _mm_max_pd(vMax, v);
+            vSum         = _mm_add_pd(vSum, v);
+        }
+        alignas(16) double lanes[3U][2U];
+        _mm_store_pd(lanes[0U], vMin);
+        _mm_store_pd(lanes[1U], vMax);
+        _mm_store_pd(lanes[2U], vSum);
+        for (auto lane = 0U; lane < 2U; ++lane)
+        {
+            summary.min = std::min(summary.min, lanes[0U][lane]);
+            summary.max = std::max(summary.max, lanes[1U][lane]);
+            summary.sum += lanes[2U][lane];
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        summary.min = std::min(summary.min, fitness[i]);
+        summary.max = std::max(summary.max, fitness[i]);
+        summary.sum += fitness[i];
+    }
+
+    // the second pass sums the squared deviations from the mean, which unlike the sum of squares does not cancel out
+    // when the deviation is small compared to the mean
+    auto const mean = summary.sum / static_cast<double>(count);
+    i               = 0U;
+#if defined(__AVX2__)
+    if (count >= 4U)
+    {
+        auto const vMean = _mm256_set1_pd(mean);
+        auto       vSqr  = _mm256_setzero_pd();
+        for (; (i + 4U) <= count; i += 4U)
+        {
+            auto const d = _mm256_sub_pd(_mm256_loadu_pd(fitness + i), vMean);
+            vSqr         = _mm256_add_pd(vSqr, _mm256_mul_pd(d, d));
+        }
+        alignas(32) double lanes[4U];
+        _mm256_store_pd(lanes, vSqr);
+        for (auto const lane : lanes)
+        {
+            summary.squaredDeviations += lane;
+        }
+    }
+#elif defined(__SSE2__)
+    if (count >= 2U)
+    {
+        auto const vMean = _mm_set1_pd(mean);
+        auto       vSqr  = _mm_setzero_pd();
+        for (; (i + 2U) <= count; i += 2U)
+        {
+            auto const d = _mm_sub_pd(_mm_loadu_pd(fitness + i), vMean);
+            vSqr         = _mm_add_pd(vSqr, _mm_mul_pd(d, d));
+        }
+        alignas(16) double lanes[2U];
+        _mm_store_pd(lanes, vSqr);
+        for (auto const lane : lanes)
+        {
+            summary.squaredDeviations += lane;
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        auto const d = fitness[i] - mean;
+        summary.squaredDeviations += d * d;
+    }
+    return summary;
+}
+
+StatisticsWriter::StatisticsWriter(std::ostream &stream, StatisticsFormat const format) noexcept
+    : _stream{&stream}, _format{format}
+{}
+
+void StatisticsWriter::operator()(Statistics const &statistics) noexcept
+{
+    auto &stream = *_stream;
+    if (_format == StatisticsFormat::Csv)
+    {
+        if (!_headerWritten)
+        {
+            stream << "generation,population,minFitness,meanFitness,maxFitness,medianFitness,upperDecileFitness,"
+                      "fitnessDeviation,initSurvivors,reproductionSurvivors,mutationSurvivors,evaluations,"
+                      "evaluationSeconds,evaluationsPerSecond\n";
+            _headerWritten = true;
+        }
+        stream << statistics.generation << ',' << statistics.population << ',' << statistics.minFitness << ','
+               << statistics.meanFitness << ',' << statistics.maxFitness << ',' << statistics.medianFitness << ','
+               << statistics.upperDecileFitness << ',' << statistics.fitnessDeviation << ','
+               << statistics.initSurvivors << ',' << statistics.reproductionSurvivors << ','
+               << statistics.mutationSurvivors << ',' << statistics.evaluations << ','
+               << statistics.evaluationSeconds << ',' << statistics.evaluationsPerSecond << '\n';
+        return;
+    }
+    stream << "{\"generation\":" << statistics.generation << ",\"population\":" << statistics.population
+           << ",\"minFitness\":" << JsonNumber{statistics.minFitness}
+           << ",\"meanFitness\":" << JsonNumber{statistics.meanFitness}
+           << ",\"maxFitness\":" << JsonNumber{statistics.maxFitness}
+           << ",\"medianFitness\":" << JsonNumber{statistics.medianFitness}
+           << ",\"upperDecileFitness\":" << JsonNumber{statistics.upperDecileFitness}
+           << ",\"fitnessDeviation\":" << JsonNumber{statistics.fitnessDeviation}
+           << ",\"initSurvivors\":" << statistics.initSurvivors
+           << ",\"reproductionSurvivors\":" << statistics.reproductionSurvivors
+           << ",\"mutationSurvivors\":" << statistics.mutationSurvivors
+           << ",\"evaluations\":" << statistics.evaluations
+           << ",\"evaluationSeconds\":" << JsonNumber{statistics.evaluationSeconds}
+           << ",\"evaluationsPerSecond\":" << JsonNumber{statistics.evaluationsPerSecond} << "}\n";
+}
+
+} // namespace Terrahertz::Optimisation::Evolution
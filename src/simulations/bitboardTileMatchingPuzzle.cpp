@@ -0,0 +1,496 @@
+#include "THzAutoGaming/simulations/bitboardTileMatchingPuzzle.hpp"
+
+#include "THzCommon/utility/spanhelpers.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Terrahertz::Simulations {
+namespace {
+
+using Word = std::uint64_t;
+
+/// @brief Writes the bitwise and of the three given arrays into the output array.
+///
+/// @param a The first input array.
+/// @param b The second input array.
+/// @param c The third input array.
+/// @param out The output array.
+/// @param count The number of words in each array.
+void andOfThree(Word const *a, Word const *b, Word const *c, Word *out, size_t const count) noexcept
+{
+    size_t i{};
+#if defined(__AVX2__)
+    for (; (i + 4U) <= count; i += 4U)
+    {
+        auto const va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + i));
+        auto const vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + i));
+        auto const vc = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(c + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_and_si256(va, _mm256_and_si256(vb, vc)));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; (i + 2U) <= count; i += 2U)
+    {
+        auto const va = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a + i));
+        auto const vb = _mm_loadu_si128(reinterpret_cast<__m128i const *>(b + i));
+        auto const vc = _mm_loadu_si128(reinterpret_cast<__m128i const *>(c + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_and_si128(va, _mm_and_si128(vb, vc)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = a[i] & b[i] & c[i];
+    }
+}
+
+/// @brief Combines the given array into the output array using bitwise or.
+///
+/// @param in The input array.
+/// @param out The output array.
+/// @param count The number of words in each array.
+void orInto(Word const *in, Word *out, size_t const count) noexcept
+{
+    size_t i{};
+#if defined(__AVX2__)
+    for (; (i + 4U) <= count; i += 4U)
+    {
+        auto *const dst = reinterpret_cast<__m256i *>(out + i);
+        auto const  src = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+        _mm256_storeu_si256(dst, _mm256_or_si256(_mm256_loadu_si256(dst), src));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; (i + 2U) <= count; i += 2U)
+    {
+        auto *const dst = reinterpret_cast<__m128i *>(out + i);
+        auto const  src = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+        _mm_storeu_si128(dst, _mm_or_si128(_mm_loadu_si128(dst), src));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] |= in[i];
+    }
+}
+
+/// @brief Marks all tiles in horizontal lines of 3 or more.
+///
+/// @param plane The bit-plane to search for lines.
+/// @param starts Buffer receiving the start positions of the lines.
+/// @param marks The bit-plane receiving the marks.
+/// @param count The number of words in the bit-plane.
+/// @param stride The number of words per column.
+void markHorizontal(Word const *plane, Word *starts, Word *marks, size_t const count, size_t const stride) noexcept
+{
+    if (count <= (2U * stride))
+    {
+        return;
+    }
+    auto const startCount = count - (2U * stride);
+    andOfThree(plane, plane + stride, plane + (2U * stride), starts, startCount);
+    orInto(starts, marks, startCount);
+    orInto(starts, marks + stride, startCount);
+    orInto(starts, marks + (2U * stride), startCount);
+}
+
+/// @brief Marks all tiles in vertical lines of 3 or more, if every column consists of a single word.
+///
+/// @param plane The bit-plane to search for lines.
+/// @param marks The bit-plane receiving the marks.
+/// @param count The number of words in the bit-plane.
+void markVerticalSingleWord(Word const *plane, Word *marks, size_t const count) noexcept
+{
+    size_t i{};
+#if defined(__AVX2__)
+    for (; (i + 4U) <= count; i += 4U)
+    {
+        auto const  p   = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(plane + i));
+        auto const  s   = _mm256_and_si256(p, _mm256_and_si256(_mm256_srli_epi64(p, 1), _mm256_srli_epi64(p, 2)));
+        auto const  m   = _mm256_or_si256(s, _mm256_or_si256(_mm256_slli_epi64(s, 1), _mm256_slli_epi64(s, 2)));
+        auto *const dst = reinterpret_cast<__m256i *>(marks + i);
+        _mm256_storeu_si256(dst, _mm256_or_si256(_mm256_loadu_si256(dst), m));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; (i + 2U) <= count; i += 2U)
+    {
+        auto const  p   = _mm_loadu_si128(reinterpret_cast<__m128i const *>(plane + i));
+        auto const  s   = _mm_and_si128(p, _mm_and_si128(_mm_srli_epi64(p, 1), _mm_srli_epi64(p, 2)));
+        auto const  m   = _mm_or_si128(s, _mm_or_si128(_mm_slli_epi64(s, 1), _mm_slli_epi64(s, 2)));
+        auto *const dst = reinterpret_cast<__m128i *>(marks + i);
+        _mm_storeu_si128(dst, _mm_or_si128(_mm_loadu_si128(dst), m));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        auto const s = plane[i] & (plane[i] >> 1U) & (plane[i] >> 2U);
+        marks[i] |= s | (s << 1U) | (s << 2U);
+    }
+}
+
+/// @brief Marks all tiles in vertical lines of 3 or more, for columns consisting of multiple words.
+///
+/// @param plane The bit-plane to search for lines.
+/// @param starts Buffer receiving the start positions of the lines.
+/// @param marks The bit-plane receiving the marks.
+/// @param columns The number of columns in the bit-plane.
+/// @param stride The number of words per column.
+void markVerticalMultiWord(
+    Word const *plane, Word *starts, Word *marks, size_t const columns, size_t const stride) noexcept
+{
+    for (size_t column{}; column < columns; ++column)
+    {
+        auto const base = column * stride;
+        for (size_t k{}; k < stride; ++k)
+        {
+            auto const p    = plane[base + k];
+            auto const next = ((k + 1U) < stride) ? plane[base + k + 1U] : Word{};
+            starts[base + k] = p & ((p >> 1U) | (next << 63U)) & ((p >> 2U) | (next << 62U));
+        }
+        for (size_t k{}; k < stride; ++k)
+        {
+            auto const s        = starts[base + k];
+            auto const previous = (k > 0U) ? starts[base + k - 1U] : Word{};
+            marks[base + k] |= s | (s << 1U) | (previous >> 63U) | (s << 2U) | (previous >> 62U);
+        }
+    }
+}
+
+} // namespace
+
+constexpr std::uint8_t BitboardTileMatchingPuzzle::EmptyTile;
+constexpr std::uint8_t BitboardTileMatchingPuzzle::ErrorTile;
+
+BitboardTileMatchingPuzzle::BitboardTileMatchingPuzzle(std::uint8_t const  width,
+                                                       std::uint8_t const  height,
+                                                       std::uint8_t const  typeCount,
+                                                       std::uint64_t const seed) noexcept
+    : _width{width},
+      _height{height},
+      _typeCount{typeCount},
+      _wordsPerColumn{(height + WordBits - 1U) / WordBits},
+      _wordsPerPlane{static_cast<size_t>(width) * _wordsPerColumn},
+      _rng{seed}
+{
+    auto const tileCount = static_cast<size_t>(_width) * _height;
+    _tiles.resize(tileCount);
+    _planes.resize(_wordsPerPlane * _typeCount);
+    _horizontal.resize(_wordsPerPlane);
+    _vertical.resize(_wordsPerPlane);
+    _starts.resize(_wordsPerPlane);
+    _horizontalGroupIds.resize(tileCount);
+    _verticalGroupIds.resize(tileCount);
+    // each line consists of at least 3 tiles, so this is enough for all group ids
+    _groups.resize(tileCount + 1U);
+    simulate();
+}
+
+std::uint8_t BitboardTileMatchingPuzzle::width() const noexcept { return _width; }
+
+std::uint8_t BitboardTileMatchingPuzzle::height() const noexcept { return _height; }
+
+std::uint8_t BitboardTileMatchingPuzzle::typeCount() const noexcept { return _typeCount; }
+
+Xoshiro256 &BitboardTileMatchingPuzzle::rng() noexcept { return _rng; }
+
+std::uint8_t BitboardTileMatchingPuzzle::operator()(std::uint8_t const x, std::uint8_t const y) const noexcept
+{
+    if ((x >= _width) || (y >= _height))
+    {
+        return ErrorTile;
+    }
+    return _tiles[tileIndex(x, y)];
+}
+
+bool BitboardTileMatchingPuzzle::setTile(std::uint8_t const x,
+                                         std::uint8_t const y,
+                                         std::uint8_t const newContent) noexcept
+{
+    if ((x >= _width) || (y >= _height))
+    {
+        return false;
+    }
+    if (newContent > _typeCount)
+    {
+        return false;
+    }
+    writeTile(x, y, newContent);
+    return true;
+}
+
+gsl::span<BitboardTileMatchingPuzzle::Collapse> BitboardTileMatchingPuzzle::simulate(bool const refill) noexcept
+{
+    _collapses.clear();
+    for (auto wave = 0U; wave < 128U; ++wave)
+    {
+        collapse(wave);
+        auto changes = gravity();
+        if (refill)
+        {
+            changes = fill();
+        }
+        if (!changes)
+        {
+            break;
+        }
+    }
+
+    auto newEnd =
+        std::remove_if(_collapses.begin(), _collapses.end(), [](Collapse const &c) { return c.type == EmptyTile; });
+    return toSpan<Collapse>(_collapses).subspan(0U, std::distance(_collapses.begin(), newEnd));
+}
+
+size_t BitboardTileMatchingPuzzle::tileIndex(std::uint32_t const x, std::uint32_t const y) const noexcept
+{
+    return (static_cast<size_t>(x) * _height) + y;
+}
+
+size_t BitboardTileMatchingPuzzle::wordIndex(std::uint32_t const x, std::uint32_t const y) const noexcept
+{
+    return (static_cast<size_t>(x) * _wordsPerColumn) + (y / WordBits);
+}
+
+BitboardTileMatchingPuzzle::Word *BitboardTileMatchingPuzzle::plane(std::uint8_t const type) noexcept
+{
+    return _planes.data() + (static_cast<size_t>(type - 1U) * _wordsPerPlane);
+}
+
+void BitboardTileMatchingPuzzle::writeTile(std::uint32_t const x,
+                                           std::uint32_t const y,
+                                           std::uint8_t const  type) noexcept
+{
+    auto &tile = _tiles[tileIndex(x, y)];
+    auto  bit  = Word{1U} << (y % WordBits);
+    if (tile != EmptyTile)
+    {
+        plane(tile)[wordIndex(x, y)] &= ~bit;
+    }
+    if (type != EmptyTile)
+    {
+        plane(type)[wordIndex(x, y)] |= bit;
+    }
+    tile = type;
+}
+
+void BitboardTileMatchingPuzzle::rebuildColumn(std::uint32_t const x) noexcept
+{
+    auto const offset = static_cast<size_t>(x) * _wordsPerColumn;
+    for (auto type = 1U; type <= _typeCount; ++type)
+    {
+        std::fill_n(plane(type) + offset, _wordsPerColumn, Word{});
+    }
+    auto const *const column = _tiles.data() + tileIndex(x, 0U);
+    for (auto y = 0U; y < _height; ++y)
+    {
+        if (column[y] != EmptyTile)
+        {
+            plane(column[y])[offset + (y / WordBits)] |= Word{1U} << (y % WordBits);
+        }
+    }
+}
+
+void BitboardTileMatchingPuzzle::findRuns() noexcept
+{
+    std::fill(_horizontal.begin(), _horizontal.end(), Word{});
+    std::fill(_vertical.begin(), _vertical.end(), Word{});
+    for (auto type = 1U; type <= _typeCount; ++type)
+    {
+        auto const *const typePlane = plane(type);
+        markHorizontal(typePlane, _starts.data(), _horizontal.data(), _wordsPerPlane, _wordsPerColumn);
+        if (_wordsPerColumn == 1U)
+        {
+            markVerticalSingleWord(typePlane, _vertical.data(), _wordsPerPlane);
+        }
+        else
+        {
+            markVerticalMultiWord(typePlane, _starts.data(), _vertical.data(), _width, _wordsPerColumn);
+        }
+    }
+}
+
+void BitboardTileMatchingPuzzle::collapse(std::uint16_t const wave) noexcept
+{
+    findRuns();
+
+    // returns the index of the collapse of the given group, starting a new collapse if the group has none yet, only
+    // the slots of the current wave are reused so the collapses stay ordered by wave
+    auto const waveStart      = _collapses.size();
+    auto const accessCollapse = [&](std::uint16_t const groupId) noexcept -> size_t {
+        auto &group = _groups[groupId];
+        if (group == 0U)
+        {
+            for (group = static_cast<std::uint16_t>(waveStart); group < _collapses.size(); ++group)
+            {
+                if (_collapses[group].type == EmptyTile)
+                {
+                    break;
+                }
+            }
+            if (group == _collapses.size())
+            {
+                _collapses.emplace_back();
+            }
+            _collapses[static_cast<size_t>(group)].wave = wave;
+            ++group;
+        }
+        return static_cast<size_t>(group) - 1U;
+    };
+
+    auto const continuesLine = [&](std::vector<Word> const &marks,
+                                   std::uint8_t const       type,
+                                   std::uint32_t const      x,
+                                   std::uint32_t const      y) noexcept -> bool {
+        auto const index = wordIndex(x, y);
+        return ((marks[index] & plane(type)[index]) & (Word{1U} << (y % WordBits))) != 0U;
+    };
+
+    // tiles are visited column by column, in the same order TileMatchingPuzzle uses,
+    // a marked neighbour of the same type is always part of the same line
+    std::uint16_t nextGroupId = 1U;
+    for (auto x = 0U; x < _width; ++x)
+    {
+        for (auto k = 0U; k < _wordsPerColumn; ++k)
+        {
+            auto const index  = (static_cast<size_t>(x) * _wordsPerColumn) + k;
+            auto       marked = _horizontal[index] | _vertical[index];
+            while (marked != 0U)
+            {
+                auto const y    = (k * WordBits) + static_cast<std::uint32_t>(std::countr_zero(marked));
+                auto const bit  = Word{1U} << (y % WordBits);
+                auto const tile = tileIndex(x, y);
+                auto const type = _tiles[tile];
+                marked &= marked - 1U;
+
+                std::uint16_t horizontalGroupId{};
+                if ((_horizontal[index] & bit) != 0U)
+                {
+                    if ((x != 0U) && continuesLine(_horizontal, type, x - 1U, y))
+                    {
+                        horizontalGroupId = _horizontalGroupIds[tile - _height];
+                    }
+                    else
+                    {
+                        horizontalGroupId = nextGroupId++;
+                    }
+                    _horizontalGroupIds[tile] = horizontalGroupId;
+                }
+                std::uint16_t verticalGroupId{};
+                if ((_vertical[index] & bit) != 0U)
+                {
+                    if ((y != 0U) && continuesLine(_vertical, type, x, y - 1U))
+                    {
+                        verticalGroupId = _verticalGroupIds[tile - 1U];
+                    }
+                    else
+                    {
+                        verticalGroupId = nextGroupId++;
+                    }
+                    _verticalGroupIds[tile] = verticalGroupId;
+                }
+
+                std::uint16_t id{};
+                if (horizontalGroupId == 0U)
+                {
+                    id = verticalGroupId;
+                }
+                else if (verticalGroupId == 0U)
+                {
+                    id = horizontalGroupId;
+                }
+                else
+                {
+                    if (_groups[horizontalGroupId] != _groups[verticalGroupId])
+                    {
+                        auto const collapseH = accessCollapse(horizontalGroupId);
+                        auto const collapseV = accessCollapse(verticalGroupId);
+                        _collapses[collapseH].amount += _collapses[collapseV].amount;
+                        _collapses[collapseV].type   = EmptyTile;
+                        _collapses[collapseV].amount = 0U;
+                        _groups[verticalGroupId]     = _groups[horizontalGroupId];
+                    }
+                    else if (_groups[horizontalGroupId] == 0U)
+                    {
+                        // the tile starts both lines, so they share a new collapse
+                        accessCollapse(horizontalGroupId);
+                        _groups[verticalGroupId] = _groups[horizontalGroupId];
+                    }
+                    id = horizontalGroupId;
+                }
+
+                auto &collapse = _collapses[accessCollapse(id)];
+                collapse.type  = type;
+                ++collapse.amount;
+                _tiles[tile] = EmptyTile;
+            }
+        }
+    }
+
+    std::fill_n(_groups.begin(), nextGroupId, std::uint16_t{});
+
+    // the planes are only updated now, as the group detection above relies on them
+    for (auto type = 1U; type <= _typeCount; ++type)
+    {
+        auto *const typePlane = plane(type);
+        for (size_t i{}; i < _wordsPerPlane; ++i)
+        {
+            typePlane[i] &= ~(_horizontal[i] | _vertical[i]);
+        }
+    }
+}
+
+bool BitboardTileMatchingPuzzle::gravity() noexcept
+{
+    auto changes = false;
+    for (auto x = 0U; x < _width; ++x)
+    {
+        auto *const column = _tiles.data() + tileIndex(x, 0U);
+        auto        bottom = static_cast<std::uint32_t>(_height);
+        auto        moved  = false;
+        for (auto y = static_cast<std::uint32_t>(_height); y-- > 0U;)
+        {
+            if (column[y] != EmptyTile)
+            {
+                --bottom;
+                if (bottom != y)
+                {
+                    // we do not need to swap as we know bottom is an empty tile
+                    column[bottom] = column[y];
+                    column[y]      = EmptyTile;
+                    moved          = true;
+                }
+            }
+        }
+        if (moved)
+        {
+            rebuildColumn(x);
+            changes = true;
+        }
+    }
+    return changes;
+}
+
+bool BitboardTileMatchingPuzzle::fill() noexcept
+{
+    auto changes = false;
+    for (auto x = 0U; x < _width; ++x)
+    {
+        for (auto y = 0U; y < _height; ++y)
+        {
+            if (_tiles[tileIndex(x, y)] == EmptyTile)
+            {
+                writeTile(x, y, static_cast<std::uint8_t>(1U + _rng.bounded(_typeCount)));
+                changes = true;
+            }
+        }
+    }
+    return changes;
+}
+
+} // namespace Terrahertz::Simulations
@@ -0,0 +1,130 @@
+#include "THzAutoGaming/simulations/moveEvaluator.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Terrahertz::Simulations {
+namespace {
+
+/// @brief The number of rollouts a thread claims at once.
+constexpr std::uint32_t RolloutsPerTask{16U};
+
+/// @brief Applies the splitmix64 finalizer to the given value.
+///
+/// @param value The value to mix.
+/// @return The mixed value.
+std::uint64_t splitmix(std::uint64_t const value) noexcept
+{
+    auto z = value + 0x9E3779B97F4A7C15ULL;
+    z      = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z      = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+/// @brief Derives the seed of a single rollout, so results do not depend on which thread performs it.
+///
+/// @param seed The seed of the evaluation.
+/// @param move The index of the move.
+/// @param rollout The index of the rollout.
+/// @return The seed of the rollout.
+/// @remarks Each input is mixed separately, so neighbouring seeds do not share rollouts.
+std::uint64_t rolloutSeed(std::uint64_t const seed, std::uint64_t const move, std::uint64_t const rollout) noexcept
+{
+    return splitmix(splitmix(splitmix(seed) ^ move) ^ rollout);
+}
+
+} // namespace
+
+double MoveEvaluator::defaultScore(TileMatchingPuzzle::Collapse const &collapse) noexcept { return collapse.amount; }
+
+MoveEvaluator::MoveEvaluator(std::uint32_t const threadCount, ScoreFunction const score) noexcept
+    : _score{score}, _pool{threadCount}
+{
+    _workers.resize(_pool.threadCount());
+}
+
+std::uint32_t MoveEvaluator::threadCount() const noexcept { return _pool.threadCount(); }
+
+gsl::span<MoveEvaluator::Statistics const>
+MoveEvaluator::evaluate(TileMatchingPuzzle const &puzzle,
+                        std::uint32_t const       rollouts,
+                        std::uint64_t const       seed) noexcept
+{
+    _moves.resize(puzzle.legalMoves({}));
+    puzzle.legalMoves(_moves);
+
+    size_t const        tasksPerMove = (rollouts + RolloutsPerTask - 1U) / RolloutsPerTask;
+    size_t const        taskCount    = tasksPerMove * _moves.size();
+    std::atomic<size_t> nextTask{};
+    _pool.run([&](std::uint32_t const index) noexcept {
+        auto &worker       = _workers[index];
+        auto &accumulators = worker.accumulators;
+        auto &state        = worker.state;
+        accumulators.assign(_moves.size(), Accumulator{});
+        puzzle.snapshot(state);
+
+        // each thread works on its own copy of the puzzle, assigning keeps the buffers of the previous evaluation
+        worker.clone = puzzle;
+        auto &clone  = *worker.clone;
+        for (auto task = nextTask.fetch_add(1U); task < taskCount; task = nextTask.fetch_add(1U))
+        {
+            auto const moveIndex = task / tasksPerMove;
+            auto const first     = static_cast<std::uint32_t>(task % tasksPerMove) * RolloutsPerTask;
+            auto const last      = std::min(first + RolloutsPerTask, rollouts);
+            auto      &result    = accumulators[moveIndex];
+            for (auto r = first; r < last; ++r)
+            {
+                state.rng.seed(rolloutSeed(seed, moveIndex, r));
+                clone.restore(state);
+                clone.swapTiles(_moves[moveIndex]);
+
+                double        score{};
+                std::uint32_t amount{};
+                std::uint32_t waves{};
+                for (auto const &collapse : clone.simulate())
+                {
+                    score += _score(collapse);
+                    amount += collapse.amount;
+                    waves = std::max(waves, collapse.wave + 1U);
+                }
+                result.score += score;
+                result.scoreSquared += score * score;
+                result.amount += amount;
+                result.waves += waves;
+                ++result.rollouts;
+            }
+        }
+    });
+
+    _statistics.resize(_moves.size());
+    for (auto i = 0U; i < _moves.size(); ++i)
+    {
+        Accumulator total{};
+        for (auto const &worker : _workers)
+        {
+            auto const &part = worker.accumulators[i];
+            total.score += part.score;
+            total.scoreSquared += part.scoreSquared;
+            total.amount += part.amount;
+            total.waves += part.waves;
+            total.rollouts += part.rollouts;
+        }
+
+        auto &statistics    = _statistics[i];
+        statistics          = Statistics{};
+        statistics.move     = _moves[i];
+        statistics.rollouts = total.rollouts;
+        if (total.rollouts != 0U)
+        {
+            auto const count         = static_cast<double>(total.rollouts);
+            statistics.meanScore     = total.score / count;
+            statistics.scoreVariance = (total.scoreSquared / count) - (statistics.meanScore * statistics.meanScore);
+            statistics.scoreVariance = std::max(statistics.scoreVariance, 0.0);
+            statistics.meanAmount    = total.amount / count;
+            statistics.meanWaves     = total.waves / count;
+        }
+    }
+    return gsl::span<Statistics const>{_statistics.data(), _statistics.size()};
+}
+
+} // namespace Terrahertz::Simulations
@@ -0,0 +1,522 @@
+#include "THzAutoGaming/simulations/tileMatchingPuzzleBatch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Terrahertz::Simulations {
+namespace {
+
+/// @brief Marks the tiles of all boards where the three given tiles form a line.
+///
+/// @param t0 The types of the first tile of all boards.
+/// @param t1 The types of the second tile of all boards.
+/// @param t2 The types of the third tile of all boards.
+/// @param m0 The marks of the first tile of all boards.
+/// @param m1 The marks of the second tile of all boards.
+/// @param m2 The marks of the third tile of all boards.
+/// @param count The number of boards.
+/// @return True if the tiles form a line on any board, false otherwise.
+bool markLine(std::uint8_t const *t0,
+              std::uint8_t const *t1,
+              std::uint8_t const *t2,
+              std::uint8_t       *m0,
+              std::uint8_t       *m1,
+              std::uint8_t       *m2,
+              size_t const        count) noexcept
+{
+    size_t i{};
+    auto   marked = false;
+#if defined(__AVX2__)
+    for (; (i + 32U) <= count; i += 32U)
+    {
+        auto const a    = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(t0 + i));
+        auto const b    = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(t1 + i));
+        auto const c    = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(t2 + i));
+        auto const same = _mm256_and_si256(_mm256_cmpeq_epi8(a, b), _mm256_cmpeq_epi8(b, c));
+        auto const line = _mm256_andnot_si256(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()), same);
+        // lines are rare, so skipping the stores is worth the branch
+        if (_mm256_movemask_epi8(line) != 0)
+        {
+            for (auto *const marks : {m0, m1, m2})
+            {
+                auto *const dst = reinterpret_cast<__m256i *>(marks + i);
+                _mm256_storeu_si256(dst, _mm256_or_si256(_mm256_loadu_si256(dst), line));
+            }
+            marked = true;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        auto const a    = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t0 + i));
+        auto const b    = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t1 + i));
+        auto const c    = _mm_loadu_si128(reinterpret_cast<__m128i const *>(t2 + i));
+        auto const same = _mm_and_si128(_mm_cmpeq_epi8(a, b), _mm_cmpeq_epi8(b, c));
+        auto const line = _mm_andnot_si128(_mm_cmpeq_epi8(a, _mm_setzero_si128()), same);
+        if (_mm_movemask_epi8(line) != 0)
+        {
+            for (auto *const marks : {m0, m1, m2})
+            {
+                auto *const dst = reinterpret_cast<__m128i *>(marks + i);
+                _mm_storeu_si128(dst, _mm_or_si128(_mm_loadu_si128(dst), line));
+            }
+            marked = true;
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        if ((t0[i] != 0U) && (t0[i] == t1[i]) && (t1[i] == t2[i]))
+        {
+            m0[i]  = 0xFFU;
+            m1[i]  = 0xFFU;
+            m2[i]  = 0xFFU;
+            marked = true;
+        }
+    }
+    return marked;
+}
+
+/// @brief Removes the marked tiles of all boards and counts them.
+///
+/// @param tiles The types of the tile of all boards.
+/// @param marks The marks of the tile of all boards, reset afterwards.
+/// @param amounts The number of removed tiles of each board.
+/// @param count The number of boards.
+/// @return True if any tile was removed, false otherwise.
+bool removeMarked(std::uint8_t *tiles, std::uint8_t *marks, std::uint16_t *amounts, size_t const count) noexcept
+{
+    size_t i{};
+    auto   removed = false;
+#if defined(__SSE2__)
+    auto anyRemoved = _mm_setzero_si128();
+    auto const one  = _mm_set1_epi8(1);
+    auto const zero = _mm_setzero_si128();
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        auto const  m     = _mm_loadu_si128(reinterpret_cast<__m128i const *>(marks + i));
+        auto *const tDst  = reinterpret_cast<__m128i *>(tiles + i);
+        auto *const aLow  = reinterpret_cast<__m128i *>(amounts + i);
+        auto *const aHigh = reinterpret_cast<__m128i *>(amounts + i + 8U);
+        auto const  ones  = _mm_and_si128(m, one);
+        _mm_storeu_si128(tDst, _mm_andnot_si128(m, _mm_loadu_si128(tDst)));
+        _mm_storeu_si128(aLow, _mm_add_epi16(_mm_loadu_si128(aLow), _mm_unpacklo_epi8(ones, zero)));
+        _mm_storeu_si128(aHigh, _mm_add_epi16(_mm_loadu_si128(aHigh), _mm_unpackhi_epi8(ones, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(marks + i), zero);
+        anyRemoved = _mm_or_si128(anyRemoved, m);
+    }
+    removed = _mm_movemask_epi8(anyRemoved) != 0;
+#endif
+    for (; i < count; ++i)
+    {
+        tiles[i] &= static_cast<std::uint8_t>(~marks[i]);
+        amounts[i] += marks[i] & 1U;
+        removed  = removed || (marks[i] != 0U);
+        marks[i] = 0U;
+    }
+    return removed;
+}
+
+/// @brief Moves the tiles of all boards down by one, if the tile below is empty.
+///
+/// @param lower The types of the lower tile of all boards.
+/// @param upper The types of the upper tile of all boards.
+/// @param count The number of boards.
+/// @return True if any tile was moved, false otherwise.
+bool fallDown(std::uint8_t *lower, std::uint8_t *upper, size_t const count) noexcept
+{
+    size_t i{};
+    auto   moved = false;
+#if defined(__AVX2__)
+    auto anyMoved = _mm256_setzero_si256();
+    for (; (i + 32U) <= count; i += 32U)
+    {
+        auto *const lDst = reinterpret_cast<__m256i *>(lower + i);
+        auto *const uDst = reinterpret_cast<__m256i *>(upper + i);
+        auto const  l    = _mm256_loadu_si256(lDst);
+        auto const  u    = _mm256_loadu_si256(uDst);
+        auto const  zero = _mm256_setzero_si256();
+        auto const  move = _mm256_andnot_si256(_mm256_cmpeq_epi8(u, zero), _mm256_cmpeq_epi8(l, zero));
+        _mm256_storeu_si256(lDst, _mm256_or_si256(l, _mm256_and_si256(u, move)));
+        _mm256_storeu_si256(uDst, _mm256_andnot_si256(move, u));
+        anyMoved = _mm256_or_si256(anyMoved, move);
+    }
+    moved = _mm256_movemask_epi8(anyMoved) != 0;
+#endif
+#if defined(__SSE2__)
+    auto anyMovedSse = _mm_setzero_si128();
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        auto *const lDst = reinterpret_cast<__m128i *>(lower + i);
+        auto *const uDst = reinterpret_cast<__m128i *>(upper + i);
+        auto const  l    = _mm_loadu_si128(lDst);
+        auto const  u    = _mm_loadu_si128(uDst);
+        auto const  zero = _mm_setzero_si128();
+        auto const  move = _mm_andnot_si128(_mm_cmpeq_epi8(u, zero), _mm_cmpeq_epi8(l, zero));
+        _mm_storeu_si128(lDst, _mm_or_si128(l, _mm_and_si128(u, move)));
+        _mm_storeu_si128(uDst, _mm_andnot_si128(move, u));
+        anyMovedSse = _mm_or_si128(anyMovedSse, move);
+    }
+    moved = moved || (_mm_movemask_epi8(anyMovedSse) != 0);
+#endif
+    for (; i < count; ++i)
+    {
+        if ((lower[i] == 0U) && (upper[i] != 0U))
+        {
+            lower[i] = upper[i];
+            upper[i] = 0U;
+            moved    = true;
+        }
+    }
+    return moved;
+}
+
+/// @brief Calls the given function for every board on which the given tile is empty.
+///
+/// @param tiles The types of the tile of all boards.
+/// @param count The number of boards.
+/// @param function The function to call with the index of the board.
+template <typename TFunction>
+void forEachEmpty(std::uint8_t const *tiles, size_t const count, TFunction const &function) noexcept
+{
+    size_t i{};
+#if defined(__SSE2__)
+    auto const zero = _mm_setzero_si128();
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        auto const tile  = _mm_loadu_si128(reinterpret_cast<__m128i const *>(tiles + i));
+        auto       empty = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(tile, zero)));
+        for (; empty != 0U; empty &= empty - 1U)
+        {
+            function(i + static_cast<size_t>(std::countr_zero(empty)));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        if (tiles[i] == 0U)
+        {
+            function(i);
+        }
+    }
+}
+
+} // namespace
+
+constexpr std::uint8_t TileMatchingPuzzleBatch::EmptyTile;
+constexpr std::uint8_t TileMatchingPuzzleBatch::ErrorTile;
+
+TileMatchingPuzzleBatch::TileMatchingPuzzleBatch(std::uint8_t const  width,
+                                                 std::uint8_t const  height,
+                                                 std::uint8_t const  typeCount,
+                                                 std::uint32_t const boardCount) noexcept
+    : _width{width}, _height{height}, _typeCount{typeCount}, _boardCount{boardCount}
+{
+    auto const size = static_cast<size_t>(_width) * _height * _boardCount;
+    _tiles.resize(size);
+    _marks.resize(size);
+    _dirtyRows.resize(_width);
+    _emptyRows.resize(_width);
+    _markedRows.resize(_width);
+    _waveAmounts.resize(_boardCount);
+    _rngs.resize(_boardCount);
+    _summaries.resize(_boardCount);
+}
+
+std::uint8_t TileMatchingPuzzleBatch::width() const noexcept { return _width; }
+
+std::uint8_t TileMatchingPuzzleBatch::height() const noexcept { return _height; }
+
+std::uint8_t TileMatchingPuzzleBatch::typeCount() const noexcept { return _typeCount; }
+
+std::uint32_t TileMatchingPuzzleBatch::boardCount() const noexcept { return _boardCount; }
+
+Xoshiro256 &TileMatchingPuzzleBatch::rng(std::uint32_t const board) noexcept { return _rngs[board]; }
+
+std::uint8_t TileMatchingPuzzleBatch::operator()(std::uint32_t const board,
+                                                 std::uint8_t const  x,
+                                                 std::uint8_t const  y) const noexcept
+{
+    if ((board >= _boardCount) || (x >= _width) || (y >= _height))
+    {
+        return ErrorTile;
+    }
+    return _tiles[tileIndex(x, y) + board];
+}
+
+bool TileMatchingPuzzleBatch::setTile(std::uint32_t const board,
+                                      std::uint8_t const  x,
+                                      std::uint8_t const  y,
+                                      std::uint8_t const  newContent) noexcept
+{
+    if ((board >= _boardCount) || (x >= _width) || (y >= _height) || (newContent > _typeCount))
+    {
+        return false;
+    }
+    _tiles[tileIndex(x, y) + board] = newContent;
+    return true;
+}
+
+bool TileMatchingPuzzleBatch::swapTiles(std::uint32_t const board, Move const &move) noexcept
+{
+    auto const otherX = move.vertical ? move.x : (move.x + 1U);
+    auto const otherY = move.vertical ? (move.y + 1U) : move.y;
+    if ((board >= _boardCount) || (otherX >= _width) || (otherY >= _height))
+    {
+        return false;
+    }
+    std::swap(_tiles[tileIndex(move.x, move.y) + board], _tiles[tileIndex(otherX, otherY) + board]);
+    return true;
+}
+
+bool TileMatchingPuzzleBatch::snapshot(std::uint32_t const board, State &state) const noexcept
+{
+    if (board >= _boardCount)
+    {
+        return false;
+    }
+    auto const tileCount = static_cast<size_t>(_width) * _height;
+    state.width          = _width;
+    state.height         = _height;
+    state.tiles.resize(tileCount);
+    for (size_t i{}; i < tileCount; ++i)
+    {
+        state.tiles[i] = _tiles[(i * _boardCount) + board];
+    }
+    state.rng = _rngs[board];
+    return true;
+}
+
+bool TileMatchingPuzzleBatch::restore(std::uint32_t const board, State const &state) noexcept
+{
+    auto const tileCount = static_cast<size_t>(_width) * _height;
+    if ((board >= _boardCount) || !fits(state))
+    {
+        return false;
+    }
+    for (size_t i{}; i < tileCount; ++i)
+    {
+        _tiles[(i * _boardCount) + board] = state.tiles[i];
+    }
+    _rngs[board] = state.rng;
+    return true;
+}
+
+bool TileMatchingPuzzleBatch::restore(State const &state) noexcept
+{
+    auto const tileCount = static_cast<size_t>(_width) * _height;
+    if (!fits(state))
+    {
+        return false;
+    }
+    for (size_t i{}; i < tileCount; ++i)
+    {
+        std::fill_n(_tiles.begin() + static_cast<std::ptrdiff_t>(i * _boardCount), _boardCount, state.tiles[i]);
+    }
+    std::fill(_rngs.begin(), _rngs.end(), state.rng);
+    return true;
+}
+
+gsl::span<TileMatchingPuzzleBatch::Summary const> TileMatchingPuzzleBatch::simulate(bool const refill) noexcept
+{
+    for (auto &summary : _summaries)
+    {
+        summary = Summary{};
+    }
+    for (auto wave = 0U; wave < 128U; ++wave)
+    {
+        // boards that are already stable do not change anymore, so they can simply run along
+        // the grids may have been altered from outside since the last call, so the first wave checks all tiles
+        collapse(wave == 0U);
+        auto changes = gravity();
+        if (refill)
+        {
+            // if gravity changed something on a board fill will change something as well
+            changes = fill();
+        }
+        if (!changes)
+        {
+            break;
+        }
+    }
+    return gsl::span<Summary const>{_summaries.data(), _summaries.size()};
+}
+
+size_t TileMatchingPuzzleBatch::tileIndex(std::uint32_t const x, std::uint32_t const y) const noexcept
+{
+    return ((static_cast<size_t>(x) * _height) + y) * _boardCount;
+}
+
+bool TileMatchingPuzzleBatch::fits(State const &state) const noexcept
+{
+    return (state.width == _width) && (state.height == _height) &&
+           (state.tiles.size() == (static_cast<size_t>(_width) * _height));
+}
+
+void TileMatchingPuzzleBatch::collapse(bool const fullScan) noexcept
+{
+    auto const  height       = static_cast<std::uint32_t>(_height);
+    auto const  columnStride = static_cast<size_t>(height) * _boardCount;
+    auto *const tiles        = _tiles.data();
+    auto *const marks        = _marks.data();
+
+    // see TileMatchingPuzzle::collapse, new lines have to contain a tile changed on any board since the last collapse
+    std::uint32_t firstColumn{};
+    std::uint32_t endColumn{};
+    std::uint32_t endRow{};
+    std::fill(_emptyRows.begin(), _emptyRows.end(), std::uint8_t{});
+    if (fullScan)
+    {
+        std::fill(_dirtyRows.begin(), _dirtyRows.end(), _height);
+        endColumn = _width;
+        endRow    = height;
+    }
+    else
+    {
+        firstColumn = _width;
+        for (auto x = 0U; x < _width; ++x)
+        {
+            if (_dirtyRows[x] != 0U)
+            {
+                firstColumn = std::min(firstColumn, x);
+                endColumn   = x + 1U;
+                endRow      = std::max<std::uint32_t>(endRow, _dirtyRows[x]);
+            }
+        }
+        if (endRow == 0U)
+        {
+            return;
+        }
+        firstColumn = (firstColumn > 2U) ? (firstColumn - 2U) : 0U;
+        endColumn   = std::min<std::uint32_t>(endColumn + 2U, _width);
+        endRow      = std::min(endRow + 2U, height);
+    }
+
+    std::fill(_markedRows.begin(), _markedRows.end(), std::uint8_t{});
+
+    // look for lines vertically
+    auto const lastVerticalStart = (height > 2U) ? (height - 2U) : 0U;
+    for (auto x = firstColumn; x < endColumn; ++x)
+    {
+        auto const starts = std::min<std::uint32_t>(_dirtyRows[x], lastVerticalStart);
+        for (auto y = 0U; y < starts; ++y)
+        {
+            auto const i = tileIndex(x, y);
+            if (markLine(tiles + i,
+                         tiles + i + _boardCount,
+                         tiles + i + (2U * _boardCount),
+                         marks + i,
+                         marks + i + _boardCount,
+                         marks + i + (2U * _boardCount),
+                         _boardCount))
+            {
+                _markedRows[x] = static_cast<std::uint8_t>(y + 3U);
+            }
+        }
+    }
+
+    // look for lines horizontally
+    for (auto x = firstColumn; (x + 2U) < endColumn; ++x)
+    {
+        auto const rows = std::max({_dirtyRows[x], _dirtyRows[x + 1U], _dirtyRows[x + 2U]});
+        for (auto y = 0U; y < rows; ++y)
+        {
+            auto const i = tileIndex(x, y);
+            if (markLine(tiles + i,
+                         tiles + i + columnStride,
+                         tiles + i + (2U * columnStride),
+                         marks + i,
+                         marks + i + columnStride,
+                         marks + i + (2U * columnStride),
+                         _boardCount))
+            {
+                for (auto column = x; column < (x + 3U); ++column)
+                {
+                    _markedRows[column] = std::max(_markedRows[column], static_cast<std::uint8_t>(y + 1U));
+                }
+            }
+        }
+    }
+    std::fill(_dirtyRows.begin(), _dirtyRows.end(), std::uint8_t{});
+
+    // remove and count all marked tiles
+    std::fill(_waveAmounts.begin(), _waveAmounts.end(), std::uint16_t{});
+    for (auto x = firstColumn; x < endColumn; ++x)
+    {
+        for (auto y = 0U; y < _markedRows[x]; ++y)
+        {
+            auto const i = tileIndex(x, y);
+            if (removeMarked(tiles + i, marks + i, _waveAmounts.data(), _boardCount))
+            {
+                _emptyRows[x] = static_cast<std::uint8_t>(y + 1U);
+            }
+        }
+    }
+    if (fullScan)
+    {
+        // empty tiles may have been set from outside
+        std::fill(_emptyRows.begin(), _emptyRows.end(), _height);
+    }
+    for (auto board = 0U; board < _boardCount; ++board)
+    {
+        if (_waveAmounts[board] != 0U)
+        {
+            _summaries[board].amount += _waveAmounts[board];
+            ++_summaries[board].waves;
+        }
+    }
+}
+
+bool TileMatchingPuzzleBatch::gravity() noexcept
+{
+    auto changes = false;
+    for (auto x = 0U; x < _width; ++x)
+    {
+        // every pass moves all tiles above an empty cell down by one, until the column is settled on all boards
+        for (auto moved = true; moved;)
+        {
+            moved = false;
+            for (auto y = _emptyRows[x] - 1U; (y > 0U) && (y < _height); --y)
+            {
+                auto *const lower = _tiles.data() + tileIndex(x, y);
+                if (fallDown(lower, lower - _boardCount, _boardCount))
+                {
+                    _dirtyRows[x] = std::max(_dirtyRows[x], static_cast<std::uint8_t>(y + 1U));
+                    moved         = true;
+                }
+            }
+            changes = changes || moved;
+        }
+    }
+    return changes;
+}
+
+bool TileMatchingPuzzleBatch::fill() noexcept
+{
+    auto changes = false;
+    // walking the tiles in the same order as TileMatchingPuzzle keeps the random sequence of each board identical
+    for (auto x = 0U; x < _width; ++x)
+    {
+        // after gravity all empty tiles are at the top of the columns
+        for (auto y = 0U; y < _emptyRows[x]; ++y)
+        {
+            auto *const tiles = _tiles.data() + tileIndex(x, y);
+            forEachEmpty(tiles, _boardCount, [&](size_t const board) noexcept {
+                tiles[board]  = static_cast<std::uint8_t>(1U + _rngs[board].bounded(_typeCount));
+                _dirtyRows[x] = std::max(_dirtyRows[x], static_cast<std::uint8_t>(y + 1U));
+                changes       = true;
+            });
+        }
+    }
+    return changes;
+}
+
+} // namespace Terrahertz::Simulations
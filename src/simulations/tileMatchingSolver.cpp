@@ -0,0 +1,230 @@
+#include "THzAutoGaming/simulations/tileMatchingSolver.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Terrahertz::Simulations {
+namespace {
+
+/// @brief Depth stored for grids without legal moves, their value does not change when searching deeper.
+constexpr std::uint8_t FinalDepth{std::numeric_limits<std::uint8_t>::max()};
+
+/// @brief Derives the seed of the refill of a single sample of a chance node.
+///
+/// @param seed The seed of the search.
+/// @param key The hash of the grid of the chance node.
+/// @param sample The index of the sample.
+/// @return The seed of the refill.
+std::uint64_t sampleSeed(std::uint64_t const seed, std::uint64_t const key, std::uint64_t const sample) noexcept
+{
+    // splitmix64 finalizer
+    auto z = seed ^ (key + ((sample + 1U) * 0x9E3779B97F4A7C15ULL));
+    z      = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z      = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+/// @brief Checks if the given moves are equal.
+///
+/// @param a The first move.
+/// @param b The second move.
+/// @return True if the moves are equal, false otherwise.
+bool sameMove(TileMatchingPuzzle::Move const &a, TileMatchingPuzzle::Move const &b) noexcept
+{
+    return (a.x == b.x) && (a.y == b.y) && (a.vertical == b.vertical);
+}
+
+} // namespace
+
+double TileMatchingSolver::defaultScore(TileMatchingPuzzle::Collapse const &collapse) noexcept
+{
+    return collapse.amount;
+}
+
+TileMatchingSolver::TileMatchingSolver() noexcept : TileMatchingSolver{Parameters{}} {}
+
+TileMatchingSolver::TileMatchingSolver(Parameters const &parameters) noexcept
+    : _parameters{parameters}, _table{parameters.tableSize}
+{
+    _parameters.maxDepth      = std::min<std::uint32_t>(_parameters.maxDepth, FinalDepth - 1U);
+    _parameters.chanceSamples = std::max(_parameters.chanceSamples, 1U);
+    // one ply per move searched ahead plus the root
+    _plies.resize(static_cast<size_t>(_parameters.maxDepth) + 1U);
+}
+
+void TileMatchingSolver::setRoot(TileMatchingPuzzle const &puzzle) noexcept
+{
+    _puzzle = puzzle;
+    _puzzle->snapshot(_plies[0U].state);
+    _plies[0U].key = _puzzle->hash();
+
+    auto &moves = _plies[0U].moves;
+    moves.resize(_puzzle->legalMoves({}));
+    _puzzle->legalMoves(moves);
+
+    // until the first iteration is completed the first legal move is the best guess
+    _rootNext   = 0U;
+    _best       = Result{};
+    _best.valid = !moves.empty();
+    if (_best.valid)
+    {
+        _best.move = moves.front();
+    }
+}
+
+bool TileMatchingSolver::search(std::chrono::nanoseconds const budget, size_t const nodes) noexcept
+{
+    if (!_puzzle || !_best.valid)
+    {
+        return true;
+    }
+    _deadline    = std::chrono::steady_clock::now() + budget;
+    _nodeLimit   = _best.nodes + std::min(nodes, std::numeric_limits<size_t>::max() - _best.nodes);
+    _progress    = false;
+    _interrupted = false;
+    while (_best.depth < _parameters.maxDepth)
+    {
+        TileMatchingPuzzle::Move move{};
+
+        auto const value = expand(0U, _best.depth + 1U, move);
+        if (_interrupted)
+        {
+            return false;
+        }
+        _best.move  = move;
+        _best.value = value;
+        ++_best.depth;
+    }
+    return true;
+}
+
+TileMatchingSolver::Result const &TileMatchingSolver::solve(TileMatchingPuzzle const &puzzle,
+                                                            std::chrono::nanoseconds const budget) noexcept
+{
+    setRoot(puzzle);
+    search(budget);
+    return _best;
+}
+
+TileMatchingSolver::Result const &TileMatchingSolver::best() const noexcept { return _best; }
+
+void TileMatchingSolver::clear() noexcept { _table.clear(); }
+
+double TileMatchingSolver::expand(std::uint32_t const       ply,
+                                  std::uint32_t const       depth,
+                                  TileMatchingPuzzle::Move &move) noexcept
+{
+    auto      &node = _plies[ply];
+    auto const key  = node.key;
+    Entry      entry{};
+    auto const known = _table.lookup(key, entry);
+    if (known && (entry.depth >= depth))
+    {
+        move = entry.move;
+        return entry.value;
+    }
+
+    // the root moves are determined by setRoot
+    if (ply != 0U)
+    {
+        node.moves.resize(_puzzle->legalMoves({}));
+        _puzzle->legalMoves(node.moves);
+    }
+    if (node.moves.empty())
+    {
+        store(key, Entry{0.0F, FinalDepth, {}});
+        return 0.0;
+    }
+    // an interrupted iteration resumes after the root moves it completed, so their order must not change
+    auto const resume = (ply == 0U) ? _rootNext : 0U;
+
+    // searching the best move of a previous search first makes interrupted iterations more useful
+    if (known && (resume == 0U))
+    {
+        auto const previous = std::find_if(node.moves.begin(), node.moves.end(), [&](auto const &m) noexcept {
+            return sameMove(m, entry.move);
+        });
+        if (previous != node.moves.end())
+        {
+            std::rotate(node.moves.begin(), previous, previous + 1);
+        }
+    }
+
+    auto bestValue = std::numeric_limits<double>::lowest();
+    if (resume != 0U)
+    {
+        bestValue = _rootValue;
+        move      = _rootMove;
+    }
+    for (auto i = resume; i < node.moves.size(); ++i)
+    {
+        auto const &candidate = node.moves[i];
+
+        double sum{};
+        for (auto sample = 0U; sample < _parameters.chanceSamples; ++sample)
+        {
+            if (interrupted())
+            {
+                return 0.0;
+            }
+            _puzzle->restore(node.state);
+            _puzzle->rng().seed(sampleSeed(_parameters.seed, key, sample));
+            _puzzle->swapTiles(candidate);
+            for (auto const &collapse : _puzzle->simulate())
+            {
+                sum += _parameters.score(collapse);
+            }
+            ++_best.nodes;
+
+            if (depth > 1U)
+            {
+                TileMatchingPuzzle::Move ignored{};
+                _puzzle->snapshot(_plies[ply + 1U].state);
+                _plies[ply + 1U].key = _puzzle->hash();
+                sum += expand(ply + 1U, depth - 1U, ignored);
+                if (_interrupted)
+                {
+                    return 0.0;
+                }
+            }
+        }
+
+        auto const value = sum / _parameters.chanceSamples;
+        if (value > bestValue)
+        {
+            bestValue = value;
+            move      = candidate;
+        }
+        if (ply == 0U)
+        {
+            _rootNext  = i + 1U;
+            _rootValue = bestValue;
+            _rootMove  = move;
+            _progress  = true;
+        }
+    }
+    if (ply == 0U)
+    {
+        _rootNext = 0U;
+    }
+    // the value is returned as stored, so it does not depend on being found in the table or not
+    auto const value = static_cast<float>(bestValue);
+    store(key, Entry{value, static_cast<std::uint8_t>(depth), move});
+    return value;
+}
+
+bool TileMatchingSolver::interrupted() noexcept
+{
+    // without completing anything the next call would start over at the same point and never finish the iteration
+    _interrupted = _interrupted || (_progress && ((_best.nodes >= _nodeLimit) ||
+                                                  (std::chrono::steady_clock::now() >= _deadline)));
+    return _interrupted;
+}
+
+void TileMatchingSolver::store(std::uint64_t const key, Entry const &entry) noexcept
+{
+    _table.store(key, entry);
+    _progress = true;
+}
+
+} // namespace Terrahertz::Simulations
@@ -0,0 +1,71 @@
+#include "THzAutoGaming/utility/threadPool.hpp"
+
+#include <algorithm>
+
+namespace Terrahertz {
+
+ThreadPool::ThreadPool(std::uint32_t const threadCount) noexcept
+{
+    auto const count = (threadCount != 0U) ? threadCount : std::max(std::thread::hardware_concurrency(), 1U);
+    _threads.reserve(count);
+    for (auto i = 0U; i < count; ++i)
+    {
+        _threads.emplace_back([this, i]() { threadMethod(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _shutdown = true;
+    }
+    _wakeUp.notify_all();
+    for (auto &thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+std::uint32_t ThreadPool::threadCount() const noexcept { return static_cast<std::uint32_t>(_threads.size()); }
+
+void ThreadPool::run(std::function<void(std::uint32_t)> const &task) noexcept
+{
+    std::unique_lock<std::mutex> lock{_mutex};
+    _task = &task;
+    _busy = threadCount();
+    ++_round;
+    _wakeUp.notify_all();
+    _done.wait(lock, [this]() noexcept { return _busy == 0U; });
+    _task = nullptr;
+}
+
+void ThreadPool::threadMethod(std::uint32_t const index) noexcept
+{
+    std::uint64_t lastRound{};
+    while (true)
+    {
+        std::function<void(std::uint32_t)> const *task{};
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _wakeUp.wait(lock, [&]() noexcept { return _shutdown || (_round != lastRound); });
+            if (_shutdown)
+            {
+                return;
+            }
+            lastRound = _round;
+            task      = _task;
+        }
+        (*task)(index);
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            --_busy;
+            if (_busy == 0U)
+            {
+                _done.notify_one();
+            }
+        }
+    }
+}
+
+} // namespace Terrahertz
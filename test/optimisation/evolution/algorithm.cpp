@@ -1,7 +1,17 @@
 #include "THzAutoGaming/optimisation/evolution/algorithm.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
 
 namespace Terrahertz::UnitTests {
 
@@ -72,10 +82,284 @@ struct TestEvaluator
     size_t *_evalCounter{};
 };
 
+/// @brief Implementor of the Individual concept counting the calls of its methods from multiple threads.
+struct ParallelTestIndividual
+{
+    void init() noexcept { ++(*_initCounter); }
+
+    void reproduce(ParallelTestIndividual const &parentA, ParallelTestIndividual const &parentB) noexcept
+    {
+        ++(*_reproduceCounter);
+    }
+
+    void mutate(ParallelTestIndividual const &parent) noexcept { ++(*_mutateCounter); }
+
+    bool save(std::ofstream &file) const noexcept { return false; }
+
+    bool load(std::ifstream &file) noexcept { return false; }
+
+    std::atomic<size_t> *_initCounter{};
+
+    std::atomic<size_t> *_reproduceCounter{};
+
+    std::atomic<size_t> *_mutateCounter{};
+};
+
+/// @brief Evaluator counting its copies and calls from multiple threads, every 16th call takes longer than the others.
+struct ParallelTestEvaluator
+{
+    ParallelTestEvaluator() noexcept = default;
+
+    ParallelTestEvaluator(std::atomic<size_t> &evalCounter, std::atomic<size_t> &copyCounter) noexcept
+        : _evalCounter{&evalCounter}, _copyCounter{&copyCounter}
+    {}
+
+    ParallelTestEvaluator(ParallelTestEvaluator const &other) noexcept
+        : _evalCounter{other._evalCounter}, _copyCounter{other._copyCounter}
+    {
+        if (_copyCounter != nullptr)
+        {
+            ++(*_copyCounter);
+        }
+    }
+
+    ParallelTestEvaluator &operator=(ParallelTestEvaluator const &other) noexcept
+    {
+        _evalCounter = other._evalCounter;
+        _copyCounter = other._copyCounter;
+        if (_copyCounter != nullptr)
+        {
+            ++(*_copyCounter);
+        }
+        return *this;
+    }
+
+    template <typename TIndividual>
+    double operator()(TIndividual const &individual) noexcept
+    {
+        if (((++(*_evalCounter)) % 16U) == 0U)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        return 0.0;
+    }
+
+    std::atomic<size_t> *_evalCounter{};
+
+    std::atomic<size_t> *_copyCounter{};
+};
+
+/// @brief Implementor of the Individual concept whose fitness is its value, mutations always improve the parent.
+struct ValueIndividual
+{
+    void init() noexcept { value = 0U; }
+
+    void reproduce(ValueIndividual const &parentA, ValueIndividual const &parentB) noexcept
+    {
+        value = std::max(parentA.value, parentB.value);
+    }
+
+    void mutate(ValueIndividual const &parent) noexcept { value = parent.value + 1U; }
+
+    bool save(std::ofstream &file) const noexcept
+    {
+        return static_cast<bool>(file.write(reinterpret_cast<char const *>(&value), sizeof(value)));
+    }
+
+    bool load(std::ifstream &file) noexcept
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(value)));
+    }
+
+    size_t value{};
+};
+
+/// @brief Evaluator returning the value of a ValueIndividual.
+struct ValueEvaluator
+{
+    double operator()(ValueIndividual const &individual) noexcept { return static_cast<double>(individual.value); }
+};
+
+/// @brief Evaluator returning the value of a ValueIndividual, optionally preferring reinitialised individuals instead.
+struct SwitchingEvaluator
+{
+    double operator()(ValueIndividual const &individual) noexcept
+    {
+        if ((*_preferReinit) && (individual.value == 0U))
+        {
+            return std::numeric_limits<double>::max();
+        }
+        return static_cast<double>(individual.value);
+    }
+
+    bool const *_preferReinit{};
+};
+
+/// @brief Evaluator without a default constructor, counting its calls from multiple threads.
+struct ReferenceEvaluator
+{
+    explicit ReferenceEvaluator(std::atomic<size_t> &calls) noexcept : _calls{&calls} {}
+
+    double operator()(ValueIndividual const &individual) noexcept
+    {
+        ++(*_calls);
+        return static_cast<double>(individual.value);
+    }
+
+    std::atomic<size_t> *_calls;
+};
+
+/// @brief Implementor of the Individual concept that can only be moved, counting the allocations of its genome.
+struct MoveOnlyIndividual
+{
+    MoveOnlyIndividual() noexcept = default;
+
+    MoveOnlyIndividual(MoveOnlyIndividual const &) = delete;
+
+    MoveOnlyIndividual &operator=(MoveOnlyIndividual const &) = delete;
+
+    MoveOnlyIndividual(MoveOnlyIndividual &&) noexcept = default;
+
+    MoveOnlyIndividual &operator=(MoveOnlyIndividual &&) noexcept = default;
+
+    void init() noexcept { genome() = 0U; }
+
+    void reproduce(MoveOnlyIndividual const &parentA, MoveOnlyIndividual const &parentB) noexcept
+    {
+        genome() = std::max(*parentA.value, *parentB.value);
+    }
+
+    void mutate(MoveOnlyIndividual const &parent) noexcept { genome() = *parent.value + 1U; }
+
+    bool save(std::ofstream &file) const noexcept
+    {
+        return static_cast<bool>(file.write(reinterpret_cast<char const *>(value.get()), sizeof(size_t)));
+    }
+
+    bool load(std::ifstream &file) noexcept
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&genome()), sizeof(size_t)));
+    }
+
+    /// @brief Returns the genome, allocating it if the individual does not own one yet.
+    size_t &genome() noexcept
+    {
+        if (!value)
+        {
+            value = std::make_unique<size_t>();
+            ++allocations;
+        }
+        return *value;
+    }
+
+    std::unique_ptr<size_t> value{};
+
+    static inline std::atomic<size_t> allocations{};
+};
+
+/// @brief Individual that can neither be copied nor default constructed, so the algorithm can not create new ones.
+struct MoveOnlyIndividualWithoutDefault
+{
+    explicit MoveOnlyIndividualWithoutDefault(size_t const pValue) noexcept : value{pValue} {}
+
+    MoveOnlyIndividualWithoutDefault(MoveOnlyIndividualWithoutDefault const &) = delete;
+
+    MoveOnlyIndividualWithoutDefault &operator=(MoveOnlyIndividualWithoutDefault const &) = delete;
+
+    MoveOnlyIndividualWithoutDefault(MoveOnlyIndividualWithoutDefault &&) noexcept = default;
+
+    MoveOnlyIndividualWithoutDefault &operator=(MoveOnlyIndividualWithoutDefault &&) noexcept = default;
+
+    void init() noexcept {}
+
+    void reproduce(MoveOnlyIndividualWithoutDefault const &parentA,
+                   MoveOnlyIndividualWithoutDefault const &parentB) noexcept
+    {}
+
+    void mutate(MoveOnlyIndividualWithoutDefault const &parent) noexcept {}
+
+    bool save(std::ofstream &file) const noexcept { return false; }
+
+    bool load(std::ifstream &file) noexcept { return false; }
+
+    size_t value{};
+};
+
+/// @brief Evaluator returning the genome of a MoveOnlyIndividual.
+struct MoveOnlyEvaluator
+{
+    double operator()(MoveOnlyIndividual const &individual) noexcept
+    {
+        return individual.value ? static_cast<double>(*individual.value) : 0.0;
+    }
+};
+
+/// @brief Implementor of the RandomizedIndividual concept trading off two objectives along its position, distance
+/// lowers both.
+struct TradeOffIndividual
+{
+    void init(std::default_random_engine &rng) noexcept
+    {
+        std::uniform_real_distribution<double> distribution{0.0, 1.0};
+        position = distribution(rng);
+        distance = distribution(rng);
+    }
+
+    void reproduce(TradeOffIndividual const   &parentA,
+                   TradeOffIndividual const   &parentB,
+                   std::default_random_engine &rng) noexcept
+    {
+        position = (parentA.position + parentB.position) * 0.5;
+        distance = std::min(parentA.distance, parentB.distance);
+    }
+
+    void mutate(TradeOffIndividual const &parent, std::default_random_engine &rng) noexcept
+    {
+        std::normal_distribution<double> distribution{0.0, 0.05};
+        position = std::clamp(parent.position + distribution(rng), 0.0, 1.0);
+        distance = std::clamp(parent.distance + distribution(rng), 0.0, 1.0);
+    }
+
+    bool save(std::ofstream &file) const noexcept
+    {
+        return static_cast<bool>(file.write(reinterpret_cast<char const *>(&position), sizeof(position))) &&
+               static_cast<bool>(file.write(reinterpret_cast<char const *>(&distance), sizeof(distance)));
+    }
+
+    bool load(std::ifstream &file) noexcept
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&position), sizeof(position))) &&
+               static_cast<bool>(file.read(reinterpret_cast<char *>(&distance), sizeof(distance)));
+    }
+
+    double position{};
+
+    double distance{};
+};
+
+/// @brief Evaluator returning the two objectives of a TradeOffIndividual, the front is reached at a distance of 0.
+struct TradeOffEvaluator
+{
+    std::array<double, 2U> operator()(TradeOffIndividual const &individual) noexcept
+    {
+        return {individual.position - individual.distance, (1.0 - individual.position) - individual.distance};
+    }
+};
+
 struct OptimisationEvolutionAlgorithm : public testing::Test
 {
     using Parameters = Optimisation::Evolution::Parameters;
 
+    using ValueAlgorithm = Optimisation::Evolution::Algorithm<ValueIndividual, ValueEvaluator>;
+
+    std::filesystem::path const checkpointPath{std::filesystem::temp_directory_path() / "thzEvolutionCheckpoint.bin"};
+
+    ~OptimisationEvolutionAlgorithm() noexcept
+    {
+        std::error_code ignored{};
+        std::filesystem::remove(checkpointPath, ignored);
+    }
+
     size_t copyCount{};
 
     size_t initCount{};
@@ -96,6 +380,8 @@ struct OptimisationEvolutionAlgorithm : public testing::Test
         EXPECT_EQ(expected.mutationPortion, actual.mutationPortion);
         EXPECT_EQ(expected.reinitPortion, actual.reinitPortion);
         EXPECT_EQ(expected.ratioDynamics, actual.ratioDynamics);
+        EXPECT_EQ(expected.evaluationThreads, actual.evaluationThreads);
+        EXPECT_EQ(expected.resampleFitness, actual.resampleFitness);
     }
 };
 
@@ -113,6 +399,8 @@ TEST_F(OptimisationEvolutionAlgorithm, ParametersDefaultValues)
     EXPECT_LT(defaultParams.reinitPortion, 1.0);
     EXPECT_GT(defaultParams.ratioDynamics, 0.0);
     EXPECT_LT(defaultParams.ratioDynamics, 1.0);
+    EXPECT_EQ(defaultParams.evaluationThreads, 1U);
+    EXPECT_FALSE(defaultParams.resampleFitness);
 }
 
 TEST_F(OptimisationEvolutionAlgorithm, ConstructionCorrect)
@@ -199,6 +487,8 @@ TEST_F(OptimisationEvolutionAlgorithm, SettingCorrectParametersUpdatesValues)
     parameters.mutationPortion += 0.1;
     parameters.reinitPortion += 0.1;
     parameters.ratioDynamics += 0.01;
+    parameters.evaluationThreads = 2U;
+    parameters.resampleFitness   = true;
     EXPECT_TRUE(sut.setParameters(parameters));
     checkParameters(parameters, sut.parameters());
 }
@@ -212,6 +502,24 @@ TEST_F(OptimisationEvolutionAlgorithm, IncreasingPopulationCopiesRootIndividual)
     EXPECT_GT(copyCount, initialCount);
 }
 
+TEST_F(OptimisationEvolutionAlgorithm, ShrinkingPopulationKeepsIndividualsAlive)
+{
+    ValueAlgorithm algorithm{};
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        algorithm.runOnce();
+    }
+    auto const best = algorithm.bestFitness();
+
+    Parameters parameters{};
+    parameters.population = 40U;
+    parameters.survivors  = 10U;
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    EXPECT_EQ(algorithm.bestFitness(), best);
+    algorithm.runOnce();
+    EXPECT_GE(algorithm.bestFitness(), best);
+}
+
 TEST_F(OptimisationEvolutionAlgorithm, FirstRunOnlyCallsInitAndEvaluatorForEveryIndividual)
 {
     sut.runOnce();
@@ -220,4 +528,635 @@ TEST_F(OptimisationEvolutionAlgorithm, FirstRunOnlyCallsInitAndEvaluatorForEvery
     EXPECT_EQ(evalCount, sut.parameters().population);
 }
 
+TEST_F(OptimisationEvolutionAlgorithm, ParallelEvaluationEvaluatesEveryIndividualOnce)
+{
+    std::atomic<size_t>   parallelEvalCount{};
+    std::atomic<size_t>   evaluatorCopyCount{};
+    ParallelTestEvaluator parallelEvaluator{parallelEvalCount, evaluatorCopyCount};
+
+    Optimisation::Evolution::Algorithm<TestIndiviual, ParallelTestEvaluator> parallel{rootIndividual,
+                                                                                      parallelEvaluator};
+
+    Parameters parameters{};
+    parameters.population        = 500U;
+    parameters.survivors         = 150U;
+    parameters.evaluationThreads = 4U;
+    auto const copiesBefore      = evaluatorCopyCount.load();
+    EXPECT_TRUE(parallel.setParameters(parameters));
+    // every thread evaluates using its own copy
+    EXPECT_GE(evaluatorCopyCount.load() - copiesBefore, 4U);
+
+    parallel.runOnce();
+    EXPECT_EQ(parallel.generation(), 1U);
+    EXPECT_EQ(initCount, parameters.population);
+    EXPECT_EQ(parallelEvalCount.load(), parameters.population);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, EvaluatorsNeedNotBeDefaultConstructible)
+{
+    std::atomic<size_t> calls{};
+
+    Optimisation::Evolution::Algorithm<ValueIndividual, ReferenceEvaluator> algorithm{ValueIndividual{},
+                                                                                      ReferenceEvaluator{calls}};
+
+    Parameters parameters{};
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    algorithm.runOnce();
+    EXPECT_EQ(calls.load(), parameters.population);
+
+    parameters.evaluationThreads = 2U;
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    algorithm.runOnce();
+    EXPECT_EQ(calls.load(), (2U * parameters.population) - parameters.survivors);
+    algorithm.runSteadyState(10U);
+    EXPECT_EQ(calls.load(), (2U * parameters.population) - parameters.survivors + 10U);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, GenerationsDoNotCopyIndividuals)
+{
+    auto const copiesAfterConstruction = copyCount;
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        sut.runOnce();
+    }
+    EXPECT_EQ(copyCount, copiesAfterConstruction);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, IndividualsMustBeCopyableOrDefaultConstructible)
+{
+    static_assert(Optimisation::Evolution::Individual<ValueIndividual>);
+    static_assert(Optimisation::Evolution::Individual<MoveOnlyIndividual>);
+    static_assert(!Optimisation::Evolution::CopyableIndividual<MoveOnlyIndividual>);
+    // the algorithm could neither copy nor default construct it, so it is rejected by the concept
+    static_assert(!Optimisation::Evolution::Individual<MoveOnlyIndividualWithoutDefault>);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RandomizedIndividualsUseTheGeneratorOfTheAlgorithm)
+{
+    static_assert(Optimisation::Evolution::RandomizedIndividual<TradeOffIndividual>);
+    static_assert(!Optimisation::Evolution::RandomizedIndividual<ValueIndividual>);
+
+    /// @brief Evaluator collecting the positions of the evaluated individuals.
+    struct CollectingEvaluator
+    {
+        double operator()(TradeOffIndividual const &individual) noexcept
+        {
+            _positions->push_back(individual.position);
+            return individual.position;
+        }
+
+        std::vector<double> *_positions{};
+    };
+    using CollectingAlgorithm = Optimisation::Evolution::Algorithm<TradeOffIndividual, CollectingEvaluator>;
+
+    std::array<std::vector<double>, 3U> positions{};
+    std::array<std::uint32_t, 3U> const seeds{7U, 7U, 8U};
+    for (auto i = 0U; i < positions.size(); ++i)
+    {
+        CollectingAlgorithm algorithm{{}, CollectingEvaluator{&positions[i]}};
+        algorithm.seed(seeds[i]);
+        algorithm.runOnce();
+        algorithm.runOnce();
+    }
+    // the individuals differ from each other and only depend on the seed of the algorithm
+    std::vector<double> initial(positions[0U].begin(), positions[0U].begin() + Parameters{}.population);
+    std::sort(initial.begin(), initial.end());
+    EXPECT_EQ(std::unique(initial.begin(), initial.end()), initial.end());
+    EXPECT_EQ(positions[0U], positions[1U]);
+    EXPECT_NE(positions[0U], positions[2U]);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, MoveOnlyIndividualsReuseTheMemoryOfEliminatedIndividuals)
+{
+    static_assert(Optimisation::Evolution::Individual<MoveOnlyIndividual>);
+    static_assert(!Optimisation::Evolution::CopyableIndividual<MoveOnlyIndividual>);
+    static_assert(Optimisation::Evolution::CopyableIndividual<TestIndiviual>);
+
+    Optimisation::Evolution::Algorithm<MoveOnlyIndividual, MoveOnlyEvaluator> algorithm{};
+
+    auto const population = algorithm.parameters().population;
+    MoveOnlyIndividual::allocations = 0U;
+    for (auto i = 0U; i < 10U; ++i)
+    {
+        algorithm.runOnce();
+    }
+    // every slot allocates its genome once, afterwards children are created in the memory of eliminated individuals
+    EXPECT_EQ(MoveOnlyIndividual::allocations.load(), population);
+    EXPECT_GT(algorithm.bestFitness(), 0.0);
+
+    Parameters parameters{};
+    parameters.evaluationThreads = 2U;
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    algorithm.runSteadyState(1000U);
+    // each thread allocates the genome of its first child once
+    EXPECT_LE(MoveOnlyIndividual::allocations.load(), population + 2U);
+
+    MoveOnlyIndividual migrant{};
+    migrant.genome() = 1000U;
+    algorithm.insert(std::move(migrant), 1000.0);
+    EXPECT_EQ(*algorithm.bestIndividual().value, 1000U);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, SurvivorsAreNotEvaluatedAgain)
+{
+    sut.runOnce();
+    sut.runOnce();
+    EXPECT_EQ(sut.generation(), 2U);
+    // only the individuals filled since the last generation are evaluated
+    auto const &parameters = sut.parameters();
+    EXPECT_EQ(evalCount, parameters.population + (parameters.population - parameters.survivors));
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, SurvivorsAreEvaluatedAgainIfResamplingIsEnabled)
+{
+    Parameters parameters{};
+    parameters.resampleFitness = true;
+    EXPECT_TRUE(sut.setParameters(parameters));
+    sut.runOnce();
+    sut.runOnce();
+    EXPECT_EQ(evalCount, 2U * parameters.population);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RefillSplitsEmptyIndividualsUsingThePortions)
+{
+    std::atomic<size_t>    inits{};
+    std::atomic<size_t>    reproductions{};
+    std::atomic<size_t>    mutations{};
+    std::atomic<size_t>    evaluations{};
+    std::atomic<size_t>    evaluatorCopies{};
+    ParallelTestIndividual root{&inits, &reproductions, &mutations};
+    ParallelTestEvaluator  parallelEvaluator{evaluations, evaluatorCopies};
+
+    Optimisation::Evolution::Algorithm<ParallelTestIndividual, ParallelTestEvaluator> algorithm{root,
+                                                                                                parallelEvaluator};
+
+    algorithm.runOnce();
+    EXPECT_EQ(inits.load(), 100U);
+    EXPECT_EQ(reproductions.load(), 0U);
+    EXPECT_EQ(mutations.load(), 0U);
+
+    // 70 empty individuals split 0.4 : 0.4 : 0.2
+    algorithm.runOnce();
+    EXPECT_EQ(inits.load(), 100U + 14U);
+    EXPECT_EQ(reproductions.load(), 28U);
+    EXPECT_EQ(mutations.load(), 28U);
+    EXPECT_EQ(evaluations.load(), 170U);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RatiosStartAtNormalizedPortions)
+{
+    Parameters parameters{};
+    parameters.reproductionPortion = 1.0;
+    parameters.mutationPortion     = 3.0;
+    parameters.reinitPortion       = 4.0;
+    EXPECT_TRUE(sut.setParameters(parameters));
+    EXPECT_DOUBLE_EQ(sut.ratios().reproduction, 0.125);
+    EXPECT_DOUBLE_EQ(sut.ratios().mutation, 0.375);
+    EXPECT_DOUBLE_EQ(sut.ratios().reinit, 0.5);
+
+    parameters.reproductionPortion = 0.0;
+    parameters.mutationPortion     = 0.0;
+    parameters.reinitPortion       = 0.0;
+    EXPECT_TRUE(sut.setParameters(parameters));
+    EXPECT_DOUBLE_EQ(sut.ratios().reproduction, 0.0);
+    EXPECT_DOUBLE_EQ(sut.ratios().mutation, 0.0);
+    EXPECT_DOUBLE_EQ(sut.ratios().reinit, 1.0);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RatiosMoveTowardsSuccessfulStrategies)
+{
+    Optimisation::Evolution::Algorithm<ValueIndividual, ValueEvaluator> algorithm{{}, {}};
+
+    Parameters parameters{};
+    parameters.ratioDynamics = 0.5;
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    for (auto i = 0U; i < 5U; ++i)
+    {
+        algorithm.runOnce();
+    }
+    auto const &ratios = algorithm.ratios();
+    // mutations always improve their parent, so they win most tournaments and reinitialised individuals never survive
+    EXPECT_GT(ratios.mutation, 0.4);
+    EXPECT_LT(ratios.reinit, 0.2);
+    EXPECT_NEAR(ratios.reproduction + ratios.mutation + ratios.reinit, 1.0, 1e-9);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RatiosRecoverAfterReachingTheFloor)
+{
+    auto preferReinit = false;
+
+    Optimisation::Evolution::Algorithm<ValueIndividual, SwitchingEvaluator> algorithm{{}, {&preferReinit}};
+
+    Parameters parameters{};
+    parameters.ratioDynamics = 0.5;
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    for (auto i = 0U; i < 50U; ++i)
+    {
+        algorithm.runOnce();
+    }
+    // reinitialised individuals never survive, but keep one slot of every refill
+    auto const floor = 1.0 / (parameters.population - parameters.survivors);
+    EXPECT_GE(algorithm.ratios().reinit, floor * 0.9);
+    EXPECT_LT(algorithm.ratios().reinit, floor * 2.0);
+
+    preferReinit = true;
+    for (auto i = 0U; i < 20U; ++i)
+    {
+        algorithm.runOnce();
+    }
+    EXPECT_GT(algorithm.ratios().reinit, 0.2);
+    EXPECT_NEAR(algorithm.ratios().reproduction + algorithm.ratios().mutation + algorithm.ratios().reinit, 1.0, 1e-9);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RatiosAreFixedWithoutDynamics)
+{
+    Optimisation::Evolution::Algorithm<ValueIndividual, ValueEvaluator> algorithm{{}, {}};
+
+    Parameters parameters{};
+    parameters.ratioDynamics = 0.0;
+    EXPECT_TRUE(algorithm.setParameters(parameters));
+    for (auto i = 0U; i < 5U; ++i)
+    {
+        algorithm.runOnce();
+    }
+    EXPECT_DOUBLE_EQ(algorithm.ratios().reproduction, 0.4);
+    EXPECT_DOUBLE_EQ(algorithm.ratios().mutation, 0.4);
+    EXPECT_DOUBLE_EQ(algorithm.ratios().reinit, 0.2);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, BestIndividualIsRootBeforeFirstRun)
+{
+    Optimisation::Evolution::Algorithm<ValueIndividual, ValueEvaluator> algorithm{ValueIndividual{.value = 7U}, {}};
+    EXPECT_EQ(algorithm.bestIndividual().value, 7U);
+    EXPECT_EQ(algorithm.bestFitness(), std::numeric_limits<double>::lowest());
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, RunUntilStopsWhenPredicateIsSatisfied)
+{
+    Optimisation::Evolution::Algorithm<ValueIndividual, ValueEvaluator> algorithm{{}, {}};
+
+    auto const generations = algorithm.runUntil([](auto const &a) noexcept { return a.bestFitness() >= 10.0; });
+    EXPECT_EQ(generations, algorithm.generation());
+    EXPECT_GE(algorithm.bestFitness(), 10.0);
+    EXPECT_EQ(static_cast<double>(algorithm.bestIndividual().value), algorithm.bestFitness());
+
+    // the predicate is checked before each generation
+    EXPECT_EQ(algorithm.runUntil([](auto const &) noexcept { return true; }), 0U);
+    EXPECT_EQ(generations, algorithm.generation());
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, SteadyStateCreatesAndEvaluatesTheGivenNumberOfChildren)
+{
+    for (auto const threads : {1U, 4U})
+    {
+        std::atomic<size_t>    inits{};
+        std::atomic<size_t>    reproductions{};
+        std::atomic<size_t>    mutations{};
+        std::atomic<size_t>    evaluations{};
+        std::atomic<size_t>    evaluatorCopies{};
+        ParallelTestIndividual root{&inits, &reproductions, &mutations};
+        ParallelTestEvaluator  parallelEvaluator{evaluations, evaluatorCopies};
+
+        Optimisation::Evolution::Algorithm<ParallelTestIndividual, ParallelTestEvaluator> steady{root,
+                                                                                               parallelEvaluator};
+
+        Parameters parameters{};
+        parameters.evaluationThreads = threads;
+        EXPECT_TRUE(steady.setParameters(parameters));
+        steady.runSteadyState(1000U);
+        EXPECT_EQ(evaluations.load(), 1000U) << "threads: " << threads;
+        EXPECT_EQ(inits.load() + reproductions.load() + mutations.load(), 1000U) << "threads: " << threads;
+        // the population starts empty, so the first children have to be initialized
+        EXPECT_GE(inits.load(), 2U) << "threads: " << threads;
+        EXPECT_GT(reproductions.load(), 0U) << "threads: " << threads;
+        EXPECT_GT(mutations.load(), 0U) << "threads: " << threads;
+        EXPECT_EQ(steady.generation(), 0U) << "threads: " << threads;
+    }
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, SteadyStateOnlyUsesReinitialisationIfOtherPortionsAreZero)
+{
+    std::atomic<size_t>    inits{};
+    std::atomic<size_t>    reproductions{};
+    std::atomic<size_t>    mutations{};
+    std::atomic<size_t>    evaluations{};
+    std::atomic<size_t>    evaluatorCopies{};
+    ParallelTestIndividual root{&inits, &reproductions, &mutations};
+    ParallelTestEvaluator  parallelEvaluator{evaluations, evaluatorCopies};
+
+    Optimisation::Evolution::Algorithm<ParallelTestIndividual, ParallelTestEvaluator> steady{root, parallelEvaluator};
+
+    Parameters parameters{};
+    parameters.reproductionPortion = 0.0;
+    parameters.mutationPortion     = 0.0;
+    EXPECT_TRUE(steady.setParameters(parameters));
+    steady.runSteadyState(300U);
+    EXPECT_EQ(inits.load(), 300U);
+    EXPECT_EQ(reproductions.load(), 0U);
+    EXPECT_EQ(mutations.load(), 0U);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, SteadyStateNeverReplacesTheBestIndividual)
+{
+    /// @brief Evaluator giving each child a lower fitness than the previous one.
+    struct DecreasingEvaluator
+    {
+        double operator()(ValueIndividual const &) noexcept { return -static_cast<double>((*_calls)++); }
+
+        size_t *_calls{};
+    };
+
+    size_t                                                                    calls{};
+    Optimisation::Evolution::Algorithm<ValueIndividual, DecreasingEvaluator> steady{ValueIndividual{},
+                                                                                    DecreasingEvaluator{&calls}};
+
+    // the first child is the best one, as the winner of every tournament it must never be replaced
+    Parameters parameters{};
+    parameters.population          = 3U;
+    parameters.survivors           = 2U;
+    parameters.reproductionPortion = 0.0;
+    parameters.mutationPortion     = 0.0;
+    EXPECT_TRUE(steady.setParameters(parameters));
+    steady.runSteadyState(300U);
+    EXPECT_EQ(calls, 300U);
+    EXPECT_EQ(steady.bestFitness(), 0.0);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, CheckpointRestoresTheRun)
+{
+    Parameters parameters{};
+    parameters.population    = 200U;
+    parameters.survivors     = 50U;
+    parameters.ratioDynamics = 0.25;
+
+    ValueAlgorithm original{};
+    EXPECT_TRUE(original.setParameters(parameters));
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        original.runOnce();
+    }
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(original.save(file));
+    }
+
+    ValueAlgorithm restored{};
+    {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(restored.load(file));
+    }
+    checkParameters(original.parameters(), restored.parameters());
+    EXPECT_EQ(restored.generation(), 3U);
+    EXPECT_EQ(restored.ratios().reproduction, original.ratios().reproduction);
+    EXPECT_EQ(restored.ratios().mutation, original.ratios().mutation);
+    EXPECT_EQ(restored.ratios().reinit, original.ratios().reinit);
+    EXPECT_EQ(restored.bestFitness(), original.bestFitness());
+
+    // the random number generator is restored as well, so both runs continue identically
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        original.runOnce();
+        restored.runOnce();
+        EXPECT_EQ(restored.bestFitness(), original.bestFitness());
+        EXPECT_EQ(restored.bestIndividual().value, original.bestIndividual().value);
+        EXPECT_EQ(restored.ratios().mutation, original.ratios().mutation);
+    }
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, CheckpointRestoresAllGeneratorsAndKeepsTheThreads)
+{
+    Parameters parameters{};
+    parameters.evaluationThreads = 2U;
+
+    ValueAlgorithm original{};
+    EXPECT_TRUE(original.setParameters(parameters));
+    original.seed(5U);
+    original.runSteadyState(100U);
+    auto const readFile = [&]() {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    };
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(original.save(file));
+    }
+    auto const saved = readFile();
+
+    // the seed and generators of the threads are restored, so saving again gives the same checkpoint
+    ValueAlgorithm restored{};
+    EXPECT_TRUE(restored.setParameters(parameters));
+    {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(restored.load(file));
+    }
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(restored.save(file));
+    }
+    EXPECT_EQ(readFile(), saved);
+
+    // the threads depend on the machine, so they are not taken from the checkpoint
+    ValueAlgorithm singleThreaded{};
+    {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(singleThreaded.load(file));
+    }
+    EXPECT_EQ(singleThreaded.parameters().evaluationThreads, 1U);
+    EXPECT_EQ(singleThreaded.bestFitness(), original.bestFitness());
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, LoadingInvalidCheckpointChangesNothing)
+{
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        file << "no checkpoint";
+    }
+    ValueAlgorithm sutValue{};
+    sutValue.runOnce();
+    auto const best = sutValue.bestFitness();
+    {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        EXPECT_FALSE(sutValue.load(file));
+    }
+    EXPECT_EQ(sutValue.generation(), 1U);
+    EXPECT_EQ(sutValue.bestFitness(), best);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, LoadingTruncatedCheckpointFails)
+{
+    ValueAlgorithm original{};
+    original.runOnce();
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(original.save(file));
+    }
+    std::filesystem::resize_file(checkpointPath, std::filesystem::file_size(checkpointPath) - 1U);
+
+    ValueAlgorithm restored{};
+    std::ifstream  file{checkpointPath, std::ios::binary};
+    EXPECT_FALSE(restored.load(file));
+    EXPECT_EQ(restored.generation(), 0U);
+    EXPECT_EQ(restored.bestFitness(), std::numeric_limits<double>::lowest());
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, SavingFailsIfIndividualCannotBeSaved)
+{
+    sut.runOnce();
+    std::ofstream file{checkpointPath, std::ios::binary};
+    EXPECT_FALSE(sut.save(file));
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, MigrantsAreExchangedThroughAFile)
+{
+    ValueAlgorithm source{};
+    source.seed(1U);
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        source.runOnce();
+    }
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(source.emigrate(file, 5U));
+    }
+
+    ValueAlgorithm target{};
+    {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(target.immigrate(file));
+    }
+    EXPECT_EQ(target.bestFitness(), source.bestFitness());
+    EXPECT_EQ(target.bestIndividual().value, source.bestIndividual().value);
+
+    // a checkpoint is not a valid set of migrants
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(source.save(file));
+    }
+    std::ifstream file{checkpointPath, std::ios::binary};
+    EXPECT_FALSE(target.immigrate(file));
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, InsertedIndividualReplacesTheWorstIfPopulationIsFull)
+{
+    ValueAlgorithm algorithm{};
+    algorithm.runSteadyState(algorithm.parameters().population);
+
+    std::vector<ValueIndividual> best{};
+    std::vector<double>          fitness{};
+    algorithm.bestIndividuals(3U, best, fitness);
+    ASSERT_EQ(best.size(), 3U);
+    EXPECT_TRUE(std::is_sorted(fitness.rbegin(), fitness.rend()));
+
+    algorithm.insert(ValueIndividual{.value = 1000U}, 1000.0);
+    EXPECT_EQ(algorithm.bestFitness(), 1000.0);
+    EXPECT_EQ(algorithm.bestIndividual().value, 1000U);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, StatisticsCallbackReceivesEveryGeneration)
+{
+    ValueAlgorithm algorithm{};
+
+    std::vector<Optimisation::Evolution::Statistics> received{};
+    algorithm.setStatisticsCallback([&](auto const &statistics) noexcept { received.push_back(statistics); });
+    algorithm.runOnce();
+    algorithm.runOnce();
+    ASSERT_EQ(received.size(), 2U);
+
+    auto const &parameters = algorithm.parameters();
+    auto const &first      = received[0U];
+    EXPECT_EQ(first.generation, 0U);
+    EXPECT_EQ(first.population, parameters.population);
+    EXPECT_EQ(first.evaluations, parameters.population);
+    // the first generation only consists of initialized individuals with a value of 0
+    EXPECT_EQ(first.minFitness, 0.0);
+    EXPECT_EQ(first.maxFitness, 0.0);
+    EXPECT_EQ(first.fitnessDeviation, 0.0);
+    EXPECT_EQ(first.initSurvivors, parameters.survivors);
+    EXPECT_EQ(first.reproductionSurvivors + first.mutationSurvivors, 0U);
+    EXPECT_GE(first.evaluationSeconds, 0.0);
+
+    auto const &second = received[1U];
+    EXPECT_EQ(second.generation, 1U);
+    EXPECT_EQ(second.evaluations, parameters.population - parameters.survivors);
+    EXPECT_EQ(second.maxFitness, 1.0);
+    EXPECT_LE(second.minFitness, second.medianFitness);
+    EXPECT_LE(second.medianFitness, second.upperDecileFitness);
+    EXPECT_LE(second.upperDecileFitness, second.maxFitness);
+    EXPECT_GT(second.meanFitness, 0.0);
+    EXPECT_GT(second.fitnessDeviation, 0.0);
+    EXPECT_LE(second.initSurvivors + second.reproductionSurvivors + second.mutationSurvivors, parameters.survivors);
+
+    algorithm.setStatisticsCallback({});
+    algorithm.runOnce();
+    EXPECT_EQ(received.size(), 2U);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, ParetoSelectionConvergesToASpreadFront)
+{
+    using TradeOffAlgorithm = Optimisation::Evolution::Algorithm<TradeOffIndividual, TradeOffEvaluator>;
+    static_assert(TradeOffAlgorithm::MultiObjective);
+    static_assert(!ValueAlgorithm::MultiObjective);
+
+    TradeOffAlgorithm algorithm{};
+    for (auto i = 0U; i < 100U; ++i)
+    {
+        algorithm.runOnce();
+    }
+
+    std::vector<TradeOffIndividual>     front{};
+    std::vector<std::array<double, 2U>> objectives{};
+    algorithm.paretoFront(front, objectives);
+    ASSERT_FALSE(front.empty());
+    ASSERT_EQ(front.size(), objectives.size());
+
+    auto minPosition = 1.0;
+    auto maxPosition = 0.0;
+    for (auto i = 0U; i < front.size(); ++i)
+    {
+        EXPECT_LT(front[i].distance, 0.05);
+        EXPECT_DOUBLE_EQ(objectives[i][0U], TradeOffEvaluator{}(front[i])[0U]);
+        EXPECT_DOUBLE_EQ(objectives[i][1U], TradeOffEvaluator{}(front[i])[1U]);
+        minPosition = std::min(minPosition, front[i].position);
+        maxPosition = std::max(maxPosition, front[i].position);
+    }
+    // the crowding distance keeps the extremes, so the front does not collapse to a single trade-off
+    EXPECT_GT(maxPosition - minPosition, 0.5);
+}
+
+TEST_F(OptimisationEvolutionAlgorithm, CheckpointRestoresTheObjectives)
+{
+    using TradeOffAlgorithm = Optimisation::Evolution::Algorithm<TradeOffIndividual, TradeOffEvaluator>;
+
+    TradeOffAlgorithm original{};
+    original.runOnce();
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(original.save(file));
+    }
+
+    TradeOffAlgorithm restored{};
+    {
+        std::ifstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(restored.load(file));
+    }
+    std::vector<TradeOffIndividual>     originalFront{};
+    std::vector<TradeOffIndividual>     restoredFront{};
+    std::vector<std::array<double, 2U>> originalObjectives{};
+    std::vector<std::array<double, 2U>> restoredObjectives{};
+    original.paretoFront(originalFront, originalObjectives);
+    restored.paretoFront(restoredFront, restoredObjectives);
+    EXPECT_EQ(restoredObjectives, originalObjectives);
+
+    // checkpoints of a single objective can not be loaded by an algorithm with several objectives
+    ValueAlgorithm scalar{};
+    scalar.runOnce();
+    {
+        std::ofstream file{checkpointPath, std::ios::binary};
+        EXPECT_TRUE(scalar.save(file));
+    }
+    std::ifstream file{checkpointPath, std::ios::binary};
+    EXPECT_FALSE(restored.load(file));
+    EXPECT_EQ(restored.generation(), 1U);
+}
+
 } // namespace Terrahertz::UnitTests
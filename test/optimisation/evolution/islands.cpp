@@ -0,0 +1,136 @@
+#include "THzAutoGaming/optimisation/evolution/islands.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace Terrahertz::UnitTests {
+
+/// @brief Implementor of the Individual concept whose fitness is its value, mutations always improve the parent.
+struct IslandIndividual
+{
+    void init() noexcept { value = 0U; }
+
+    void reproduce(IslandIndividual const &parentA, IslandIndividual const &parentB) noexcept
+    {
+        value = std::max(parentA.value, parentB.value);
+    }
+
+    void mutate(IslandIndividual const &parent) noexcept { value = parent.value + 1U; }
+
+    bool save(std::ofstream &file) const noexcept { return false; }
+
+    bool load(std::ifstream &file) noexcept { return false; }
+
+    size_t value{};
+};
+
+/// @brief Evaluator returning the value of an IslandIndividual.
+struct IslandEvaluator
+{
+    double operator()(IslandIndividual const &individual) noexcept { return static_cast<double>(individual.value); }
+};
+
+struct OptimisationEvolutionIslands : public testing::Test
+{
+    using IslandParameters = Optimisation::Evolution::IslandParameters;
+
+    using Islands = Optimisation::Evolution::Islands<IslandIndividual, IslandEvaluator>;
+};
+
+TEST_F(OptimisationEvolutionIslands, IslandParametersDefaultValues)
+{
+    IslandParameters const defaultParams{};
+    EXPECT_GT(defaultParams.islands, 1U);
+    EXPECT_GT(defaultParams.migrationInterval, 0U);
+    EXPECT_GT(defaultParams.migrants, 0U);
+}
+
+TEST_F(OptimisationEvolutionIslands, ConstructionCreatesAtLeastOneIsland)
+{
+    Islands none{{.islands = 0U}};
+    EXPECT_EQ(none.islandParameters().islands, 1U);
+
+    Islands sut{{.islands = 3U}};
+    EXPECT_EQ(sut.islandParameters().islands, 3U);
+    EXPECT_EQ(sut.generation(), 0U);
+    EXPECT_EQ(sut.island(2U).generation(), 0U);
+}
+
+TEST_F(OptimisationEvolutionIslands, ParametersAreSetOnEveryIsland)
+{
+    Islands sut{{.islands = 3U}};
+
+    Optimisation::Evolution::Parameters parameters{};
+    parameters.population = 50U;
+    parameters.survivors  = 10U;
+    EXPECT_TRUE(sut.setParameters(parameters));
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        EXPECT_EQ(sut.island(i).parameters().population, 50U);
+        EXPECT_EQ(sut.island(i).parameters().survivors, 10U);
+    }
+
+    parameters.survivors = 60U;
+    EXPECT_FALSE(sut.setParameters(parameters));
+    EXPECT_EQ(sut.parameters().survivors, 10U);
+}
+
+TEST_F(OptimisationEvolutionIslands, RunOnceRunsEveryIsland)
+{
+    Islands sut{{.islands = 3U, .migrationInterval = 0U}};
+    sut.runOnce();
+    sut.runOnce();
+    EXPECT_EQ(sut.generation(), 2U);
+    for (auto i = 0U; i < 3U; ++i)
+    {
+        EXPECT_EQ(sut.island(i).generation(), 2U);
+        EXPECT_LE(sut.island(i).bestFitness(), sut.bestFitness());
+    }
+}
+
+TEST_F(OptimisationEvolutionIslands, MigrationSpreadsTheBestIndividuals)
+{
+    static constexpr double Unique{1000.0};
+
+    Islands sut{{.islands = 3U, .migrationInterval = 1U, .migrants = 1U}};
+    sut.runOnce();
+    sut.island(0U).insert(IslandIndividual{.value = static_cast<size_t>(Unique)}, Unique);
+
+    // each migration moves the best individual of an island to the next island of the ring
+    sut.runOnce();
+    EXPECT_GE(sut.island(0U).bestFitness(), Unique);
+    EXPECT_GE(sut.island(1U).bestFitness(), Unique);
+    EXPECT_LT(sut.island(2U).bestFitness(), Unique);
+
+    sut.runOnce();
+    EXPECT_GE(sut.island(2U).bestFitness(), Unique);
+    EXPECT_EQ(static_cast<double>(sut.bestIndividual().value), sut.bestFitness());
+}
+
+TEST_F(OptimisationEvolutionIslands, NoMigrationKeepsTheBestIndividualOnItsIsland)
+{
+    static constexpr double Unique{1000.0};
+
+    Islands sut{{.islands = 3U, .migrationInterval = 0U}};
+    sut.runOnce();
+    sut.island(0U).insert(IslandIndividual{.value = static_cast<size_t>(Unique)}, Unique);
+    for (auto generation = 0U; generation < 3U; ++generation)
+    {
+        sut.runOnce();
+    }
+    EXPECT_GE(sut.island(0U).bestFitness(), Unique);
+    EXPECT_LT(sut.island(1U).bestFitness(), Unique);
+    EXPECT_LT(sut.island(2U).bestFitness(), Unique);
+}
+
+TEST_F(OptimisationEvolutionIslands, RunUntilStopsWhenPredicateIsSatisfied)
+{
+    Islands sut{{.islands = 2U}};
+
+    auto const generations = sut.runUntil([](auto const &islands) noexcept { return islands.bestFitness() >= 8.0; });
+    EXPECT_EQ(generations, sut.generation());
+    EXPECT_GE(sut.bestFitness(), 8.0);
+}
+
+} // namespace Terrahertz::UnitTests
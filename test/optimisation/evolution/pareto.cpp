@@ -0,0 +1,171 @@
+#include "THzAutoGaming/optimisation/evolution/pareto.hpp"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct OptimisationEvolutionPareto : public testing::Test
+{
+    /// @brief Determines the fronts by repeatedly removing the non-dominated individuals, taking O(M N^3).
+    ///
+    /// @tparam TObjectives The number of objectives.
+    /// @param objectives The objectives of all individuals.
+    /// @return The index of the front of each individual.
+    template <size_t TObjectives>
+    static std::vector<std::uint32_t> bruteForceRanks(std::vector<std::array<double, TObjectives>> const &objectives)
+    {
+        std::vector<std::uint32_t> ranks(objectives.size(), std::numeric_limits<std::uint32_t>::max());
+        for (std::uint32_t rank = 0U, ranked = 0U; ranked < objectives.size(); ++rank)
+        {
+            std::vector<size_t> front{};
+            for (auto i = 0U; i < objectives.size(); ++i)
+            {
+                if (ranks[i] < rank)
+                {
+                    continue;
+                }
+                auto dominated = false;
+                for (auto j = 0U; !dominated && (j < objectives.size()); ++j)
+                {
+                    dominated = (ranks[j] >= rank) && Optimisation::Evolution::dominates(objectives[j], objectives[i]);
+                }
+                if (!dominated)
+                {
+                    front.push_back(i);
+                }
+            }
+            for (auto const i : front)
+            {
+                ranks[i] = rank;
+            }
+            ranked += static_cast<std::uint32_t>(front.size());
+        }
+        return ranks;
+    }
+
+    /// @brief Creates random objectives, rounded to few distinct values so there are ties and duplicates.
+    ///
+    /// @tparam TObjectives The number of objectives.
+    /// @param count The number of individuals.
+    /// @return The objectives of the individuals.
+    template <size_t TObjectives>
+    static std::vector<std::array<double, TObjectives>> randomObjectives(size_t const count)
+    {
+        std::minstd_rand                            rng{42U};
+        std::uniform_int_distribution<std::int32_t> distribution{0, 20};
+
+        std::vector<std::array<double, TObjectives>> objectives(count);
+        for (auto &individual : objectives)
+        {
+            for (auto &objective : individual)
+            {
+                objective = distribution(rng);
+            }
+        }
+        return objectives;
+    }
+
+    /// @brief Checks the ranks determined by nonDominatedSort against the brute force ones.
+    ///
+    /// @tparam TObjectives The number of objectives.
+    /// @param objectives The objectives of all individuals.
+    template <size_t TObjectives>
+    static void checkRanks(std::vector<std::array<double, TObjectives>> const &objectives)
+    {
+        std::vector<std::uint32_t> candidates(objectives.size());
+        for (auto i = 0U; i < candidates.size(); ++i)
+        {
+            candidates[i] = i;
+        }
+        std::vector<std::uint32_t>              ranks(objectives.size());
+        std::vector<std::vector<std::uint32_t>> fronts{};
+
+        auto const count    = Optimisation::Evolution::nonDominatedSort(objectives, candidates, ranks, fronts);
+        auto const expected = bruteForceRanks(objectives);
+        EXPECT_EQ(ranks, expected);
+
+        size_t members{};
+        for (auto f = 0U; f < count; ++f)
+        {
+            for (auto const member : fronts[f])
+            {
+                EXPECT_EQ(ranks[member], f);
+            }
+            members += fronts[f].size();
+        }
+        EXPECT_EQ(members, objectives.size());
+    }
+};
+
+TEST_F(OptimisationEvolutionPareto, ObjectiveCountOfFitnessTypes)
+{
+    EXPECT_EQ(Optimisation::Evolution::ObjectiveCount<double>, 1U);
+    EXPECT_EQ((Optimisation::Evolution::ObjectiveCount<std::array<double, 3U>>), 3U);
+    EXPECT_EQ(Optimisation::Evolution::ObjectiveCount<float>, 0U);
+}
+
+TEST_F(OptimisationEvolutionPareto, Dominates)
+{
+    using Objectives = std::array<double, 2U>;
+    EXPECT_TRUE(Optimisation::Evolution::dominates(Objectives{2.0, 1.0}, Objectives{1.0, 1.0}));
+    EXPECT_FALSE(Optimisation::Evolution::dominates(Objectives{1.0, 1.0}, Objectives{2.0, 1.0}));
+    EXPECT_FALSE(Optimisation::Evolution::dominates(Objectives{1.0, 1.0}, Objectives{1.0, 1.0}));
+    EXPECT_FALSE(Optimisation::Evolution::dominates(Objectives{2.0, 0.0}, Objectives{1.0, 1.0}));
+}
+
+TEST_F(OptimisationEvolutionPareto, SortingTwoObjectivesMatchesBruteForce)
+{
+    checkRanks(randomObjectives<2U>(500U));
+}
+
+TEST_F(OptimisationEvolutionPareto, SortingThreeObjectivesMatchesBruteForce)
+{
+    checkRanks(randomObjectives<3U>(500U));
+}
+
+TEST_F(OptimisationEvolutionPareto, SortingReusesTheFrontsOfPreviousCalls)
+{
+    std::vector<std::array<double, 2U>>     objectives{{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}};
+    std::vector<std::uint32_t>              candidates{0U, 1U, 2U};
+    std::vector<std::uint32_t>              ranks(objectives.size());
+    std::vector<std::vector<std::uint32_t>> fronts{};
+    EXPECT_EQ(Optimisation::Evolution::nonDominatedSort(objectives, candidates, ranks, fronts), 3U);
+
+    candidates = {0U, 2U};
+    EXPECT_EQ(Optimisation::Evolution::nonDominatedSort(objectives, candidates, ranks, fronts), 2U);
+    EXPECT_EQ(fronts[0U], std::vector<std::uint32_t>{2U});
+    EXPECT_EQ(fronts[1U], std::vector<std::uint32_t>{0U});
+    EXPECT_TRUE(fronts[2U].empty());
+}
+
+TEST_F(OptimisationEvolutionPareto, CrowdingDistanceKeepsTheExtremes)
+{
+    std::vector<std::array<double, 2U>> objectives{{0.0, 4.0}, {1.0, 3.0}, {3.0, 1.0}, {4.0, 0.0}, {2.0, 2.0}};
+    std::vector<std::uint32_t>          front{0U, 1U, 2U, 3U, 4U};
+    std::vector<double>                 distances(objectives.size());
+    Optimisation::Evolution::crowdingDistance(objectives, front, distances);
+
+    EXPECT_EQ(distances[0U], std::numeric_limits<double>::infinity());
+    EXPECT_EQ(distances[3U], std::numeric_limits<double>::infinity());
+    // each neighbour interval is normalized by the range of its objective and summed over both objectives
+    EXPECT_DOUBLE_EQ(distances[1U], 1.0);
+    EXPECT_DOUBLE_EQ(distances[2U], 1.0);
+    EXPECT_DOUBLE_EQ(distances[4U], 1.0);
+}
+
+TEST_F(OptimisationEvolutionPareto, CrowdingDistanceOfSmallFrontsIsInfinite)
+{
+    std::vector<std::array<double, 2U>> objectives{{0.0, 1.0}, {1.0, 0.0}};
+    std::vector<std::uint32_t>          front{0U, 1U};
+    std::vector<double>                 distances(objectives.size());
+    Optimisation::Evolution::crowdingDistance(objectives, front, distances);
+    EXPECT_EQ(distances[0U], std::numeric_limits<double>::infinity());
+    EXPECT_EQ(distances[1U], std::numeric_limits<double>::infinity());
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,123 @@
+#include "THzAutoGaming/optimisation/evolution/statistics.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct OptimisationEvolutionStatistics : public testing::Test
+{
+    Optimisation::Evolution::Statistics statistics{.generation            = 3U,
+                                                   .population            = 100U,
+                                                   .minFitness            = -1.5,
+                                                   .meanFitness           = 2.0,
+                                                   .maxFitness            = 8.0,
+                                                   .medianFitness         = 1.5,
+                                                   .upperDecileFitness    = 6.0,
+                                                   .fitnessDeviation      = 0.5,
+                                                   .initSurvivors         = 4U,
+                                                   .reproductionSurvivors = 5U,
+                                                   .mutationSurvivors     = 6U,
+                                                   .evaluations           = 70U,
+                                                   .evaluationSeconds     = 0.25,
+                                                   .evaluationsPerSecond  = 280.0};
+};
+
+TEST_F(OptimisationEvolutionStatistics, SummaryMatchesScalarCalculation)
+{
+    // odd counts make sure the remainders of the vectorized loops are included
+    for (auto const count : {1U, 2U, 3U, 4U, 5U, 7U, 8U, 9U, 100U, 1001U})
+    {
+        std::vector<double> fitness(count);
+        for (auto i = 0U; i < count; ++i)
+        {
+            fitness[i] = static_cast<double>((i * 7919U) % 211U) - 100.0;
+        }
+        double sum{};
+        for (auto const value : fitness)
+        {
+            sum += value;
+        }
+        double squaredDeviations{};
+        for (auto const value : fitness)
+        {
+            squaredDeviations += (value - (sum / count)) * (value - (sum / count));
+        }
+
+        auto const summary = Optimisation::Evolution::summarizeFitness(fitness.data(), count);
+        EXPECT_EQ(summary.min, *std::min_element(fitness.begin(), fitness.end())) << "count: " << count;
+        EXPECT_EQ(summary.max, *std::max_element(fitness.begin(), fitness.end())) << "count: " << count;
+        EXPECT_DOUBLE_EQ(summary.sum, sum) << "count: " << count;
+        EXPECT_NEAR(summary.squaredDeviations, squaredDeviations, squaredDeviations * 1e-12) << "count: " << count;
+    }
+}
+
+TEST_F(OptimisationEvolutionStatistics, SummaryIsAccurateForSmallDeviationsOfLargeValues)
+{
+    // the values alternate between 1e9 - 1 and 1e9 + 1, so the squared deviations sum up to the count
+    std::vector<double> fitness(1001U);
+    for (auto i = 0U; i < fitness.size(); ++i)
+    {
+        fitness[i] = 1e9 + (((i % 2U) == 0U) ? -1.0 : 1.0);
+    }
+    fitness.back() = 1e9;
+
+    auto const summary = Optimisation::Evolution::summarizeFitness(fitness.data(), fitness.size());
+    EXPECT_NEAR(summary.squaredDeviations, 1000.0, 1e-3);
+}
+
+TEST_F(OptimisationEvolutionStatistics, CsvWriterWritesHeaderOnce)
+{
+    std::ostringstream                        stream{};
+    Optimisation::Evolution::StatisticsWriter sut{stream, Optimisation::Evolution::StatisticsFormat::Csv};
+    sut(statistics);
+    sut(statistics);
+
+    std::istringstream lines{stream.str()};
+    std::string        line{};
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line.rfind("generation,population,minFitness,", 0U), 0U);
+    EXPECT_EQ(std::count(line.begin(), line.end(), ','), 13);
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line, "3,100,-1.5,2,8,1.5,6,0.5,4,5,6,70,0.25,280");
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line, "3,100,-1.5,2,8,1.5,6,0.5,4,5,6,70,0.25,280");
+    EXPECT_FALSE(std::getline(lines, line));
+}
+
+TEST_F(OptimisationEvolutionStatistics, JsonLinesWriterWritesOneObjectPerLine)
+{
+    std::ostringstream                        stream{};
+    Optimisation::Evolution::StatisticsWriter sut{stream, Optimisation::Evolution::StatisticsFormat::JsonLines};
+    sut(statistics);
+
+    EXPECT_EQ(stream.str(),
+              "{\"generation\":3,\"population\":100,\"minFitness\":-1.5,\"meanFitness\":2,\"maxFitness\":8,"
+              "\"medianFitness\":1.5,\"upperDecileFitness\":6,\"fitnessDeviation\":0.5,\"initSurvivors\":4,"
+              "\"reproductionSurvivors\":5,\"mutationSurvivors\":6,\"evaluations\":70,\"evaluationSeconds\":0.25,"
+              "\"evaluationsPerSecond\":280}\n");
+}
+
+TEST_F(OptimisationEvolutionStatistics, JsonLinesWriterWritesNonFiniteNumbersAsNull)
+{
+    statistics.minFitness           = -std::numeric_limits<double>::infinity();
+    statistics.maxFitness           = std::numeric_limits<double>::infinity();
+    statistics.meanFitness          = std::numeric_limits<double>::quiet_NaN();
+    statistics.evaluationsPerSecond = std::numeric_limits<double>::infinity();
+
+    std::ostringstream                        stream{};
+    Optimisation::Evolution::StatisticsWriter sut{stream, Optimisation::Evolution::StatisticsFormat::JsonLines};
+    sut(statistics);
+
+    EXPECT_EQ(stream.str(),
+              "{\"generation\":3,\"population\":100,\"minFitness\":null,\"meanFitness\":null,\"maxFitness\":null,"
+              "\"medianFitness\":1.5,\"upperDecileFitness\":6,\"fitnessDeviation\":0.5,\"initSurvivors\":4,"
+              "\"reproductionSurvivors\":5,\"mutationSurvivors\":6,\"evaluations\":70,\"evaluationSeconds\":0.25,"
+              "\"evaluationsPerSecond\":null}\n");
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,241 @@
+#include "THzAutoGaming/simulations/basicTileMatchingPuzzle.hpp"
+
+#include "THzAutoGaming/simulations/collapseRules.hpp"
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsBasicTileMatchingPuzzle : public testing::Test
+{
+    static constexpr std::uint8_t GridWidth{8U};
+    static constexpr std::uint8_t GridHeight{8U};
+    static constexpr std::uint8_t TypeCount{5U};
+
+    using Puzzle = Simulations::BasicTileMatchingPuzzle<GridWidth, GridHeight, TypeCount>;
+
+    Puzzle sut{};
+
+    /// @brief Compares the grid of the puzzle to the grid of the reference.
+    template <typename TPuzzle>
+    void compareGrids(TPuzzle const &puzzle, Simulations::TileMatchingPuzzle const &reference)
+    {
+        ASSERT_EQ(puzzle.width(), reference.width());
+        ASSERT_EQ(puzzle.height(), reference.height());
+        for (auto x = 0U; x < reference.width(); ++x)
+        {
+            for (auto y = 0U; y < reference.height(); ++y)
+            {
+                ASSERT_EQ(puzzle(x, y), reference(x, y)) << "x: " << x << " y: " << y;
+            }
+        }
+    }
+
+    /// @brief Randomly alters tiles of both puzzles and compares the results of the simulation.
+    ///
+    /// @tparam TPuzzle The instantiation of BasicTileMatchingPuzzle to check.
+    /// @param refill Flag passed on to simulate.
+    template <typename TPuzzle>
+    void checkEquivalence(bool const refill)
+    {
+        TPuzzle                         puzzle{};
+        Simulations::TileMatchingPuzzle reference{puzzle.width(), puzzle.height(), puzzle.typeCount()};
+        compareGrids(puzzle, reference);
+
+        std::mt19937                                 changes{42U};
+        std::uniform_int_distribution<std::uint32_t> xDist{0U, puzzle.width() - 1U};
+        std::uniform_int_distribution<std::uint32_t> yDist{0U, puzzle.height() - 1U};
+        std::uniform_int_distribution<std::uint32_t> typeDist{0U, puzzle.typeCount()};
+        for (auto round = 0U; round < 200U; ++round)
+        {
+            for (auto i = 0U; i < 4U; ++i)
+            {
+                auto const x    = static_cast<std::uint8_t>(xDist(changes));
+                auto const y    = static_cast<std::uint8_t>(yDist(changes));
+                auto const type = static_cast<std::uint8_t>(typeDist(changes));
+                ASSERT_TRUE(puzzle.setTile(x, y, type));
+                ASSERT_TRUE(reference.setTile(x, y, type));
+            }
+            auto const expected = reference.simulate(refill);
+            auto const actual   = puzzle.simulate(refill);
+            ASSERT_EQ(actual.size(), expected.size()) << "round: " << round;
+            for (auto c = 0U; c < expected.size(); ++c)
+            {
+                EXPECT_EQ(actual[c].type, expected[c].type) << "round: " << round << " collapse: " << c;
+                EXPECT_EQ(actual[c].amount, expected[c].amount) << "round: " << round << " collapse: " << c;
+                EXPECT_EQ(actual[c].wave, expected[c].wave) << "round: " << round << " collapse: " << c;
+            }
+            compareGrids(puzzle, reference);
+        }
+    }
+};
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, ValidStateAfterConstruction)
+{
+    static_assert(Puzzle::width() == GridWidth);
+    static_assert(Puzzle::height() == GridHeight);
+    static_assert(Puzzle::typeCount() == TypeCount);
+
+    for (auto y = 0U; y < GridHeight; ++y)
+    {
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            auto const value = sut(x, y);
+            ASSERT_NE(Puzzle::EmptyTile, value);
+            ASSERT_NE(Puzzle::ErrorTile, value);
+        }
+    }
+    EXPECT_TRUE(sut.simulate().empty());
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, TileCoordinatesOutOfBoundReturnsErrorTile)
+{
+    EXPECT_EQ(sut(GridWidth, 0U), Puzzle::ErrorTile);
+    EXPECT_EQ(sut(0U, GridHeight), Puzzle::ErrorTile);
+    EXPECT_EQ(sut(GridWidth, GridHeight), Puzzle::ErrorTile);
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, SetTileOutOfBoundOrIllegalValueReturnsFalse)
+{
+    EXPECT_FALSE(sut.setTile(GridWidth, 0U, 2U));
+    EXPECT_FALSE(sut.setTile(0U, GridHeight, 2U));
+    auto const originalCellValue = sut(2U, 2U);
+    EXPECT_FALSE(sut.setTile(2U, 2U, TypeCount + 1U));
+    EXPECT_EQ(originalCellValue, sut(2U, 2U));
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, SwapTilesExchangesNeighbours)
+{
+    auto const left  = sut(3U, 3U);
+    auto const right = sut(4U, 3U);
+    auto const below = sut(3U, 4U);
+    EXPECT_TRUE(sut.swapTiles({3U, 3U, false}));
+    EXPECT_EQ(sut(3U, 3U), right);
+    EXPECT_EQ(sut(4U, 3U), left);
+    EXPECT_TRUE(sut.swapTiles({3U, 3U, false}));
+    EXPECT_TRUE(sut.swapTiles({3U, 3U, true}));
+    EXPECT_EQ(sut(3U, 3U), below);
+    EXPECT_EQ(sut(3U, 4U), left);
+    EXPECT_FALSE(sut.swapTiles({GridWidth - 1U, 0U, false}));
+    EXPECT_FALSE(sut.swapTiles({0U, GridHeight - 1U, true}));
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, SameResultsAsTileMatchingPuzzleWithoutRefill)
+{
+    checkEquivalence<Puzzle>(false);
+    checkEquivalence<Simulations::BasicTileMatchingPuzzle<9U, 9U, 3U>>(false);
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, SameResultsAsTileMatchingPuzzleWithRefill)
+{
+    checkEquivalence<Puzzle>(true);
+    checkEquivalence<Simulations::BasicTileMatchingPuzzle<12U, 12U, 3U>>(true);
+    checkEquivalence<Simulations::BasicTileMatchingPuzzle<7U, 10U, 4U>>(true);
+    checkEquivalence<Simulations::BasicTileMatchingPuzzle<6U, 130U, 3U>>(true);
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, DynamicExtentsGiveSameResultsAsCompileTimeExtents)
+{
+    using Rules   = Simulations::SpecialTileRules;
+    using Static  = Simulations::BasicTileMatchingPuzzle<GridWidth, GridHeight, TypeCount, Rules>;
+    using Dynamic = Simulations::BasicTileMatchingPuzzle<Simulations::DynamicExtent,
+                                                         Simulations::DynamicExtent,
+                                                         Simulations::DynamicExtent,
+                                                         Rules>;
+
+    Static  puzzle{};
+    Dynamic reference{GridWidth, GridHeight, TypeCount};
+
+    std::mt19937                                 changes{42U};
+    std::uniform_int_distribution<std::uint32_t> positionDist{0U, GridWidth - 1U};
+    std::uniform_int_distribution<std::uint32_t> typeDist{1U, TypeCount};
+    std::uniform_int_distribution<std::uint32_t> specialDist{0U, 3U};
+    for (auto round = 0U; round < 200U; ++round)
+    {
+        for (auto i = 0U; i < 4U; ++i)
+        {
+            auto const x       = static_cast<std::uint8_t>(positionDist(changes));
+            auto const y       = static_cast<std::uint8_t>(positionDist(changes));
+            auto const special = static_cast<Rules::Special>(specialDist(changes));
+            auto const tile    = Rules::makeTile(static_cast<std::uint8_t>(typeDist(changes)), special);
+            ASSERT_TRUE(puzzle.setTile(x, y, tile));
+            ASSERT_TRUE(reference.setTile(x, y, tile));
+        }
+        auto const expected = reference.simulate();
+        auto const actual   = puzzle.simulate();
+        ASSERT_EQ(actual.size(), expected.size()) << "round: " << round;
+        for (auto c = 0U; c < expected.size(); ++c)
+        {
+            EXPECT_EQ(actual[c].type, expected[c].type) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(actual[c].shape, expected[c].shape) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(actual[c].amount, expected[c].amount) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(actual[c].wave, expected[c].wave) << "round: " << round << " collapse: " << c;
+        }
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                ASSERT_EQ(puzzle(x, y), reference(x, y)) << "round: " << round << " x: " << x << " y: " << y;
+            }
+        }
+    }
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, SameLegalMovesAsTileMatchingPuzzle)
+{
+    Simulations::TileMatchingPuzzle                                 reference{GridWidth, GridHeight, TypeCount};
+    std::array<Puzzle::Move, 2U * GridWidth * GridHeight>           moves{};
+    std::array<Simulations::TileMatchingPuzzle::Move, moves.size()> expectedMoves{};
+    for (auto round = 0U; round < 20U; ++round)
+    {
+        auto const count = sut.legalMoves(moves);
+        ASSERT_EQ(count, reference.legalMoves(expectedMoves));
+        for (auto i = 0U; i < count; ++i)
+        {
+            EXPECT_EQ(moves[i].x, expectedMoves[i].x);
+            EXPECT_EQ(moves[i].y, expectedMoves[i].y);
+            EXPECT_EQ(moves[i].vertical, expectedMoves[i].vertical);
+        }
+        ASSERT_NE(count, 0U);
+        EXPECT_TRUE(sut.swapTiles(moves[round % count]));
+        EXPECT_TRUE(reference.swapTiles(moves[round % count]));
+        sut.simulate();
+        reference.simulate();
+    }
+}
+
+TEST_F(SimulationsBasicTileMatchingPuzzle, RestoringSnapshotReproducesSimulation)
+{
+    Puzzle::State state{};
+    sut.snapshot(state);
+    EXPECT_TRUE(sut.swapTiles({2U, 2U, false}));
+    auto const                                  first = sut.simulate();
+    std::vector<Puzzle::Collapse>               expected{first.begin(), first.end()};
+    std::array<std::uint8_t, Puzzle::TileCount> expectedTiles{};
+    for (auto i = 0U; i < Puzzle::TileCount; ++i)
+    {
+        expectedTiles[i] = sut(i / GridHeight, i % GridHeight);
+    }
+
+    sut.restore(state);
+    EXPECT_TRUE(sut.swapTiles({2U, 2U, false}));
+    auto const second = sut.simulate();
+    ASSERT_EQ(second.size(), expected.size());
+    for (auto c = 0U; c < expected.size(); ++c)
+    {
+        EXPECT_EQ(second[c].type, expected[c].type);
+        EXPECT_EQ(second[c].amount, expected[c].amount);
+        EXPECT_EQ(second[c].wave, expected[c].wave);
+    }
+    for (auto i = 0U; i < Puzzle::TileCount; ++i)
+    {
+        EXPECT_EQ(sut(i / GridHeight, i % GridHeight), expectedTiles[i]);
+    }
+}
+
+} // namespace Terrahertz::UnitTests
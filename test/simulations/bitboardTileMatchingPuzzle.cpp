@@ -0,0 +1,137 @@
+#include "THzAutoGaming/simulations/bitboardTileMatchingPuzzle.hpp"
+
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsBitboardTileMatchingPuzzle : public testing::Test
+{
+    static constexpr std::uint8_t GridWidth{8U};
+    static constexpr std::uint8_t GridHeight{8U};
+    static constexpr std::uint8_t TypeCount{5U};
+
+    Simulations::BitboardTileMatchingPuzzle sut{GridWidth, GridHeight, TypeCount};
+
+    /// @brief Compares the grid of the sut to the grid of the reference.
+    void compareGrids(Simulations::BitboardTileMatchingPuzzle const &bitboard,
+                      Simulations::TileMatchingPuzzle const         &reference)
+    {
+        ASSERT_EQ(bitboard.width(), reference.width());
+        ASSERT_EQ(bitboard.height(), reference.height());
+        for (auto x = 0U; x < reference.width(); ++x)
+        {
+            for (auto y = 0U; y < reference.height(); ++y)
+            {
+                ASSERT_EQ(bitboard(x, y), reference(x, y)) << "x: " << x << " y: " << y;
+            }
+        }
+    }
+
+    /// @brief Randomly alters tiles of both puzzles and compares the results of the simulation.
+    ///
+    /// @param width The width of the grids.
+    /// @param height The height of the grids.
+    /// @param typeCount The number of types of tiles.
+    /// @param refill Flag passed on to simulate.
+    void checkEquivalence(std::uint8_t const width,
+                          std::uint8_t const height,
+                          std::uint8_t const typeCount,
+                          bool const         refill)
+    {
+        Simulations::BitboardTileMatchingPuzzle bitboard{width, height, typeCount};
+        Simulations::TileMatchingPuzzle         reference{width, height, typeCount};
+        compareGrids(bitboard, reference);
+
+        std::mt19937                                 changes{42U};
+        std::uniform_int_distribution<std::uint32_t> xDist{0U, width - 1U};
+        std::uniform_int_distribution<std::uint32_t> yDist{0U, height - 1U};
+        std::uniform_int_distribution<std::uint32_t> typeDist{0U, typeCount};
+        for (auto round = 0U; round < 200U; ++round)
+        {
+            for (auto i = 0U; i < 4U; ++i)
+            {
+                auto const x    = static_cast<std::uint8_t>(xDist(changes));
+                auto const y    = static_cast<std::uint8_t>(yDist(changes));
+                auto const type = static_cast<std::uint8_t>(typeDist(changes));
+                ASSERT_TRUE(bitboard.setTile(x, y, type));
+                ASSERT_TRUE(reference.setTile(x, y, type));
+            }
+            auto const expected = reference.simulate(refill);
+            auto const actual   = bitboard.simulate(refill);
+            ASSERT_EQ(actual.size(), expected.size()) << "round: " << round;
+            for (auto c = 0U; c < expected.size(); ++c)
+            {
+                EXPECT_EQ(actual[c].type, expected[c].type) << "round: " << round << " collapse: " << c;
+                EXPECT_EQ(actual[c].amount, expected[c].amount) << "round: " << round << " collapse: " << c;
+                EXPECT_EQ(actual[c].wave, expected[c].wave) << "round: " << round << " collapse: " << c;
+            }
+            compareGrids(bitboard, reference);
+        }
+    }
+};
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, ValidStateAfterConstruction)
+{
+    EXPECT_EQ(sut.width(), GridWidth);
+    EXPECT_EQ(sut.height(), GridHeight);
+    EXPECT_EQ(sut.typeCount(), TypeCount);
+
+    for (auto y = 0U; y < GridHeight; ++y)
+    {
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            auto const value = sut(x, y);
+            ASSERT_NE(Simulations::BitboardTileMatchingPuzzle::EmptyTile, value);
+            ASSERT_NE(Simulations::BitboardTileMatchingPuzzle::ErrorTile, value);
+        }
+    }
+    EXPECT_TRUE(sut.simulate().empty());
+}
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, TileCoordinatesOutOfBoundReturnsErrorTile)
+{
+    EXPECT_EQ(sut(GridWidth, 0U), Simulations::BitboardTileMatchingPuzzle::ErrorTile);
+    EXPECT_EQ(sut(0U, GridHeight), Simulations::BitboardTileMatchingPuzzle::ErrorTile);
+    EXPECT_EQ(sut(GridWidth, GridHeight), Simulations::BitboardTileMatchingPuzzle::ErrorTile);
+}
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, SetTileOutOfBoundOrIllegalValueReturnsFalse)
+{
+    EXPECT_FALSE(sut.setTile(GridWidth, 0U, 2U));
+    EXPECT_FALSE(sut.setTile(0U, GridHeight, 2U));
+    auto const originalCellValue = sut(2U, 2U);
+    EXPECT_FALSE(sut.setTile(2U, 2U, TypeCount + 1U));
+    EXPECT_EQ(originalCellValue, sut(2U, 2U));
+}
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, SettingValueUpdatesGrid)
+{
+    EXPECT_TRUE(sut.setTile(3U, 3U, 2U));
+    EXPECT_EQ(sut(3U, 3U), 2U);
+}
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, SameResultsAsTileMatchingPuzzleWithoutRefill)
+{
+    checkEquivalence(8U, 8U, 5U, false);
+    checkEquivalence(9U, 9U, 3U, false);
+}
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, SameResultsAsTileMatchingPuzzleWithRefill)
+{
+    checkEquivalence(8U, 8U, 5U, true);
+    checkEquivalence(9U, 9U, 6U, true);
+    checkEquivalence(12U, 12U, 3U, true);
+    checkEquivalence(7U, 10U, 4U, true);
+}
+
+TEST_F(SimulationsBitboardTileMatchingPuzzle, SameResultsAsTileMatchingPuzzleForColumnsSpanningMultipleWords)
+{
+    checkEquivalence(5U, 70U, 3U, false);
+    checkEquivalence(6U, 130U, 3U, true);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,195 @@
+#include "THzAutoGaming/simulations/collapseRules.hpp"
+
+#include "THzAutoGaming/simulations/basicTileMatchingPuzzle.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <utility>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsCollapseRules : public testing::Test
+{
+    static constexpr std::uint8_t GridWidth{8U};
+    static constexpr std::uint8_t GridHeight{8U};
+    static constexpr std::uint8_t TypeCount{5U};
+
+    /// @brief The type only used for the lines placed by the tests.
+    static constexpr std::uint8_t LineType{5U};
+
+    using Rules   = Simulations::SpecialTileRules;
+    using Special = Rules::Special;
+    using Shape   = Simulations::TileMatchingTypes::Shape;
+    using Puzzle  = Simulations::BasicTileMatchingPuzzle<GridWidth, GridHeight, TypeCount, Rules>;
+
+    Puzzle sut{};
+
+    /// @brief Fills the grid with a pattern of the types 1 to 4 that does not contain any lines.
+    void SetUp() override
+    {
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                ASSERT_TRUE(sut.setTile(x, y, static_cast<std::uint8_t>(((x + (2U * y)) % 4U) + 1U)));
+            }
+        }
+        ASSERT_TRUE(sut.simulate(false).empty());
+    }
+
+    /// @brief Sets the given tiles to the LineType.
+    void placeLine(std::initializer_list<std::pair<std::uint8_t, std::uint8_t>> const tiles)
+    {
+        for (auto const &[x, y] : tiles)
+        {
+            ASSERT_TRUE(sut.setTile(x, y, LineType));
+        }
+    }
+
+    /// @brief Checks the content of the given collapse.
+    void checkCollapse(Puzzle::Collapse const &collapse,
+                       std::uint8_t const      type,
+                       Shape const             shape,
+                       std::uint16_t const     amount)
+    {
+        EXPECT_EQ(collapse.type, type);
+        EXPECT_EQ(collapse.shape, shape);
+        EXPECT_EQ(collapse.amount, amount);
+        EXPECT_EQ(collapse.wave, 0U);
+    }
+};
+
+TEST_F(SimulationsCollapseRules, PlainRulesDoNotDetermineShapes)
+{
+    Simulations::BasicTileMatchingPuzzle<GridWidth, GridHeight, TypeCount> puzzle{};
+    for (auto x = 0U; x < 3U; ++x)
+    {
+        ASSERT_TRUE(puzzle.setTile(x, 0U, 1U));
+    }
+    auto const result = puzzle.simulate();
+    ASSERT_FALSE(result.empty());
+    for (auto const &collapse : result)
+    {
+        EXPECT_EQ(collapse.shape, Shape::Unknown);
+    }
+}
+
+TEST_F(SimulationsCollapseRules, SpecialTilesMatchTilesOfTheSameType)
+{
+    EXPECT_TRUE(sut.setTile(0U, 0U, Rules::makeTile(LineType, Special::Bomb)));
+    EXPECT_FALSE(sut.setTile(0U, 0U, Rules::makeTile(TypeCount + 1U, Special::Bomb)));
+    // special bits not naming a special and specials without a type cannot be decoded
+    EXPECT_FALSE(sut.setTile(0U, 0U, static_cast<std::uint8_t>(LineType | (4U << Rules::SpecialShift))));
+    EXPECT_FALSE(sut.setTile(0U, 0U, Rules::makeTile(Puzzle::EmptyTile, Special::Striped)));
+    EXPECT_FALSE(sut.setTile(0U, 0U, Puzzle::ErrorTile));
+    EXPECT_EQ(sut(0U, 0U), Rules::makeTile(LineType, Special::Bomb));
+    placeLine({{1U, 0U}, {2U, 0U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_GE(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::Line3, 3U);
+}
+
+TEST_F(SimulationsCollapseRules, Line3DoesNotCreateSpecialTile)
+{
+    placeLine({{0U, 0U}, {1U, 0U}, {2U, 0U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::Line3, 3U);
+    for (auto x = 0U; x < 3U; ++x)
+    {
+        EXPECT_EQ(sut(x, 0U), Puzzle::EmptyTile);
+    }
+}
+
+TEST_F(SimulationsCollapseRules, Line4CreatesStripedTile)
+{
+    placeLine({{0U, 0U}, {1U, 0U}, {2U, 0U}, {3U, 0U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::Line4, 4U);
+    EXPECT_EQ(sut(0U, 0U), Rules::makeTile(LineType, Special::Striped));
+    for (auto x = 1U; x < 4U; ++x)
+    {
+        EXPECT_EQ(sut(x, 0U), Puzzle::EmptyTile);
+    }
+}
+
+TEST_F(SimulationsCollapseRules, Line5CreatesRainbowTile)
+{
+    placeLine({{0U, 0U}, {0U, 1U}, {0U, 2U}, {0U, 3U}, {0U, 4U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::Line5, 5U);
+    // the special tile replaces the top tile of the line and falls down
+    EXPECT_EQ(sut(0U, 4U), Rules::makeTile(LineType, Special::Rainbow));
+    for (auto y = 0U; y < 4U; ++y)
+    {
+        EXPECT_EQ(sut(0U, y), Puzzle::EmptyTile);
+    }
+}
+
+TEST_F(SimulationsCollapseRules, LShapeCreatesBomb)
+{
+    placeLine({{0U, 0U}, {1U, 0U}, {2U, 0U}, {0U, 1U}, {0U, 2U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::L, 5U);
+    EXPECT_EQ(sut(0U, 2U), Rules::makeTile(LineType, Special::Bomb));
+}
+
+TEST_F(SimulationsCollapseRules, TShapeCreatesBomb)
+{
+    placeLine({{0U, 0U}, {1U, 0U}, {2U, 0U}, {1U, 1U}, {1U, 2U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::T, 5U);
+    EXPECT_EQ(sut(1U, 2U), Rules::makeTile(LineType, Special::Bomb));
+}
+
+TEST_F(SimulationsCollapseRules, CrossCreatesBomb)
+{
+    placeLine({{0U, 1U}, {1U, 1U}, {2U, 1U}, {1U, 0U}, {1U, 2U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    checkCollapse(result[0U], LineType, Shape::Cross, 5U);
+    EXPECT_EQ(sut(1U, 2U), Rules::makeTile(LineType, Special::Bomb));
+}
+
+TEST_F(SimulationsCollapseRules, CollapsingStripedTileClearsItsColumn)
+{
+    EXPECT_TRUE(sut.setTile(3U, 5U, Rules::makeTile(LineType, Special::Striped)));
+    placeLine({{2U, 5U}, {4U, 5U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 2U);
+    checkCollapse(result[0U], LineType, Shape::Line3, 3U);
+    checkCollapse(result[1U], LineType, Shape::Effect, GridHeight - 1U);
+    for (auto y = 0U; y < GridHeight; ++y)
+    {
+        EXPECT_EQ(sut(3U, y), Puzzle::EmptyTile);
+    }
+}
+
+TEST_F(SimulationsCollapseRules, SpecialTilesClearedByEffectsTriggerAsWell)
+{
+    EXPECT_TRUE(sut.setTile(3U, 5U, Rules::makeTile(LineType, Special::Striped)));
+    EXPECT_TRUE(sut.setTile(3U, 1U, Rules::makeTile(1U, Special::Bomb)));
+    placeLine({{2U, 5U}, {4U, 5U}});
+
+    auto const result = sut.simulate(false);
+    ASSERT_GE(result.size(), 3U);
+    checkCollapse(result[0U], LineType, Shape::Line3, 3U);
+    checkCollapse(result[1U], LineType, Shape::Effect, GridHeight - 1U);
+    // the bomb clears the 3x3 tiles around it, the tiles of its own column have already been cleared
+    checkCollapse(result[2U], 1U, Shape::Effect, 6U);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,103 @@
+#include "THzAutoGaming/simulations/moveEvaluator.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsMoveEvaluator : public testing::Test
+{
+    static constexpr std::uint8_t  GridWidth{8U};
+    static constexpr std::uint8_t  GridHeight{8U};
+    static constexpr std::uint8_t  TypeCount{5U};
+    static constexpr std::uint32_t Rollouts{40U};
+
+    Simulations::TileMatchingPuzzle puzzle{GridWidth, GridHeight, TypeCount};
+
+    Simulations::MoveEvaluator sut{4U};
+};
+
+TEST_F(SimulationsMoveEvaluator, ConstructionCorrect) { EXPECT_EQ(sut.threadCount(), 4U); }
+
+TEST_F(SimulationsMoveEvaluator, EveryLegalMoveIsEvaluated)
+{
+    std::vector<Simulations::TileMatchingPuzzle::Move> moves(puzzle.legalMoves({}));
+    puzzle.legalMoves(moves);
+    ASSERT_FALSE(moves.empty());
+
+    auto const result = sut.evaluate(puzzle, Rollouts);
+    ASSERT_EQ(result.size(), moves.size());
+    for (auto i = 0U; i < moves.size(); ++i)
+    {
+        EXPECT_EQ(result[i].move.x, moves[i].x);
+        EXPECT_EQ(result[i].move.y, moves[i].y);
+        EXPECT_EQ(result[i].move.vertical, moves[i].vertical);
+        EXPECT_EQ(result[i].rollouts, Rollouts);
+        // every legal move collapses at least one line
+        EXPECT_GE(result[i].meanAmount, 3.0);
+        EXPECT_GE(result[i].meanWaves, 1.0);
+        EXPECT_EQ(result[i].meanScore, result[i].meanAmount);
+        EXPECT_GE(result[i].scoreVariance, 0.0);
+    }
+}
+
+TEST_F(SimulationsMoveEvaluator, EvaluationDoesNotChangeThePuzzle)
+{
+    Simulations::TileMatchingPuzzle::State before{};
+    puzzle.snapshot(before);
+    sut.evaluate(puzzle, Rollouts);
+    Simulations::TileMatchingPuzzle::State after{};
+    puzzle.snapshot(after);
+    EXPECT_EQ(before.tiles, after.tiles);
+}
+
+TEST_F(SimulationsMoveEvaluator, ResultsDoNotDependOnTheNumberOfThreads)
+{
+    Simulations::MoveEvaluator singleThreaded{1U};
+
+    auto const expected = singleThreaded.evaluate(puzzle, Rollouts, 1234U);
+    auto const actual   = sut.evaluate(puzzle, Rollouts, 1234U);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0U; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(actual[i].rollouts, expected[i].rollouts);
+        EXPECT_EQ(actual[i].meanScore, expected[i].meanScore);
+        EXPECT_EQ(actual[i].scoreVariance, expected[i].scoreVariance);
+        EXPECT_EQ(actual[i].meanAmount, expected[i].meanAmount);
+        EXPECT_EQ(actual[i].meanWaves, expected[i].meanWaves);
+    }
+}
+
+TEST_F(SimulationsMoveEvaluator, ReusedEvaluatorGivesSameResultsForOtherGrids)
+{
+    Simulations::TileMatchingPuzzle smaller{6U, 6U, TypeCount, 42U};
+    Simulations::MoveEvaluator      fresh{4U};
+
+    sut.evaluate(puzzle, Rollouts, 1234U);
+    auto const expected = fresh.evaluate(smaller, Rollouts, 1234U);
+    auto const actual   = sut.evaluate(smaller, Rollouts, 1234U);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0U; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(actual[i].meanScore, expected[i].meanScore);
+        EXPECT_EQ(actual[i].meanWaves, expected[i].meanWaves);
+    }
+}
+
+TEST_F(SimulationsMoveEvaluator, ScoreFunctionIsUsed)
+{
+    Simulations::MoveEvaluator custom{2U, [](Simulations::TileMatchingPuzzle::Collapse const &c) noexcept -> double {
+                                          return (c.wave == 0U) ? 0.0 : 1.0;
+                                      }};
+
+    auto const result = custom.evaluate(puzzle, Rollouts);
+    ASSERT_FALSE(result.empty());
+    for (auto const &statistics : result)
+    {
+        EXPECT_LT(statistics.meanScore, statistics.meanAmount);
+        EXPECT_GE(statistics.meanScore, 0.0);
+    }
+}
+
+} // namespace Terrahertz::UnitTests
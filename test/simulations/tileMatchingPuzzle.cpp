@@ -1,8 +1,37 @@
 #include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
 
+#include "THzAutoGaming/simulations/basicTileMatchingPuzzle.hpp"
+#include "THzAutoGaming/simulations/bitboardTileMatchingPuzzle.hpp"
+#include "THzAutoGaming/simulations/collapseRules.hpp"
+
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
 #include <gtest/gtest.h>
+#include <new>
 #include <utility>
+#include <vector>
+
+namespace {
+
+/// @brief The number of calls to the global operator new, used to check that simulations do not allocate.
+std::atomic<size_t> allocationCount{};
+
+} // namespace
+
+void *operator new(size_t const size)
+{
+    ++allocationCount;
+    if (auto const memory = std::malloc((size == 0U) ? 1U : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *const memory) noexcept { std::free(memory); }
+
+void operator delete(void *const memory, size_t const) noexcept { std::free(memory); }
 
 namespace Terrahertz::UnitTests {
 
@@ -129,6 +158,47 @@ TEST_F(SimulationsTileMatchingPuzzle, ValidStateAfterConstruction)
     compareReplica(false);
 }
 
+TEST_F(SimulationsTileMatchingPuzzle, SameSeedCreatesSameGrid)
+{
+    Simulations::TileMatchingPuzzle sutA{GridWidth, GridHeight, TypeCount, 1234U};
+    Simulations::TileMatchingPuzzle sutB{GridWidth, GridHeight, TypeCount, 1234U};
+    Simulations::TileMatchingPuzzle sutC{GridWidth, GridHeight, TypeCount, 4321U};
+
+    auto differences = 0U;
+    for (auto y = 0U; y < GridHeight; ++y)
+    {
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            ASSERT_EQ(sutA(x, y), sutB(x, y)) << "x: " << x << " y: " << y;
+            if (sutA(x, y) != sutC(x, y))
+            {
+                ++differences;
+            }
+        }
+    }
+    EXPECT_GT(differences, 0U);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, ReseedingMakesRefillReproducible)
+{
+    Simulations::TileMatchingPuzzle::State state{};
+    sut.snapshot(state);
+
+    auto const clearAndRefill = [&]() {
+        sut.rng().seed(42U);
+        EXPECT_TRUE(sut.setTile(2U, 2U, EmptyTile));
+        EXPECT_TRUE(sut.setTile(2U, 3U, EmptyTile));
+        EXPECT_TRUE(sut.setTile(5U, 6U, EmptyTile));
+        sut.simulate();
+    };
+    clearAndRefill();
+    replicate();
+
+    EXPECT_TRUE(sut.restore(state));
+    clearAndRefill();
+    compareReplica(false);
+}
+
 TEST_F(SimulationsTileMatchingPuzzle, TileCoordinatesOutOfBoundReturnsErrorTile)
 {
     EXPECT_EQ(sut(GridWidth, 0U), Simulations::TileMatchingPuzzle::ErrorTile);
@@ -163,6 +233,29 @@ TEST_F(SimulationsTileMatchingPuzzle, SettingValueUpdatesGrid)
     EXPECT_EQ(sut(x, y), 2U);
 }
 
+TEST_F(SimulationsTileMatchingPuzzle, SwapTilesExchangesNeighbours)
+{
+    fillGrid();
+    replicate();
+
+    EXPECT_TRUE(sut.swapTiles({2U, 3U, false}));
+    std::swap(stateReplica[2U][3U], stateReplica[3U][3U]);
+    compareReplica(false);
+
+    EXPECT_TRUE(sut.swapTiles({4U, 1U, true}));
+    std::swap(stateReplica[4U][1U], stateReplica[4U][2U]);
+    compareReplica(false);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, SwapTilesOutOfBoundReturnsFalseAndDoesNoChange)
+{
+    replicate();
+    EXPECT_FALSE(sut.swapTiles({GridWidth - 1U, 0U, false}));
+    EXPECT_FALSE(sut.swapTiles({0U, GridHeight - 1U, true}));
+    EXPECT_FALSE(sut.swapTiles({GridWidth, GridHeight, true}));
+    compareReplica(false);
+}
+
 TEST_F(SimulationsTileMatchingPuzzle, GravityFillsCellsWithTheContentFromAbove)
 {
     fillGrid();
@@ -502,6 +595,43 @@ TEST_F(SimulationsTileMatchingPuzzle, CollapseOfAngle)
     compareReplica(false);
 }
 
+TEST_F(SimulationsTileMatchingPuzzle, CollapseOfAngleStartingAtItsCorner)
+{
+    fillGrid();
+
+    //    0 1 2 3 4 5 6 7       0 1 2 3 4 5 6 7
+    //  _________________     _________________
+    // 0| 1 2 3 4 5 1 2 3    0| 1 0 0 0 5 1 2 3
+    // 1| 2 4 4 4 1 2 3 4    1| 2 0 3 4 1 2 3 4
+    // 2| 3 4 5 1 2 3 4 5    2| 3 0 5 1 2 3 4 5
+    // 3| 4 4 1 2 3 4 5 1 -> 3| 4 2 1 2 3 4 5 1
+    // 4| 5 1 2 3 4 5 1 2    4| 5 1 2 3 4 5 1 2
+    // 5| 1 2 3 4 5 1 2 3    5| 1 2 3 4 5 1 2 3
+    // 6| 2 3 4 5 1 2 3 4    6| 2 3 4 5 1 2 3 4
+    // 7| 3 4 5 1 2 3 4 5    7| 3 4 5 1 2 3 4 5
+
+    EXPECT_TRUE(sut.setTile(1U, 1U, 4U));
+    EXPECT_TRUE(sut.setTile(3U, 1U, 4U));
+    EXPECT_TRUE(sut.setTile(1U, 3U, 4U));
+
+    replicate();
+    // simulate collapse
+    stateReplica[1U][1U] = EmptyTile;
+    stateReplica[2U][1U] = EmptyTile;
+    stateReplica[3U][1U] = EmptyTile;
+    stateReplica[1U][2U] = EmptyTile;
+    stateReplica[1U][3U] = EmptyTile;
+    simulateGravity();
+
+    auto result = sut.simulate(false);
+    ASSERT_EQ(result.size(), 1U);
+    EXPECT_EQ(result[0U].type, 4U);
+    EXPECT_EQ(result[0U].amount, 5U);
+    EXPECT_EQ(result[0U].wave, 0U);
+
+    compareReplica(false);
+}
+
 TEST_F(SimulationsTileMatchingPuzzle, CollapseOfTPiece)
 {
     fillGrid();
@@ -708,4 +838,432 @@ TEST_F(SimulationsTileMatchingPuzzle, CollapseCascadesCorrectly)
     compareReplica(false);
 }
 
+TEST_F(SimulationsTileMatchingPuzzle, RestoringSnapshotReproducesSimulation)
+{
+    Simulations::TileMatchingPuzzle::State state{};
+    sut.snapshot(state);
+    EXPECT_EQ(state.tiles.size(), static_cast<size_t>(GridWidth) * GridHeight);
+
+    auto const swapAndSimulate = [&]() noexcept {
+        EXPECT_TRUE(sut.swapTiles(Simulations::TileMatchingPuzzle::Move{3U, 3U, false}));
+        auto const result = sut.simulate();
+        return std::vector<Simulations::TileMatchingPuzzle::Collapse>(result.begin(), result.end());
+    };
+    auto const expected = swapAndSimulate();
+    replicate();
+
+    EXPECT_TRUE(sut.restore(state));
+    auto const actual = swapAndSimulate();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (auto i = 0U; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(actual[i].type, expected[i].type);
+        EXPECT_EQ(actual[i].amount, expected[i].amount);
+        EXPECT_EQ(actual[i].wave, expected[i].wave);
+    }
+    compareReplica(false);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, RestoringSnapshotOfDifferentSizeReturnsFalseAndDoesNoChange)
+{
+    Simulations::TileMatchingPuzzle        other{GridWidth + 1U, GridHeight, TypeCount};
+    Simulations::TileMatchingPuzzle::State state{};
+    other.snapshot(state);
+
+    replicate();
+    EXPECT_FALSE(sut.restore(state));
+    compareReplica(false);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, RestoringSnapshotOfTransposedSizeReturnsFalseAndDoesNoChange)
+{
+    // both grids have the same number of tiles, so only the width and height tell them apart
+    Simulations::TileMatchingPuzzle        wide{12U, 6U, TypeCount};
+    Simulations::TileMatchingPuzzle        tall{6U, 12U, TypeCount};
+    Simulations::TileMatchingPuzzle::State wideState{};
+    Simulations::TileMatchingPuzzle::State tallState{};
+    wide.snapshot(wideState);
+    tall.snapshot(tallState);
+
+    EXPECT_FALSE(tall.restore(wideState));
+    Simulations::TileMatchingPuzzle::State unchanged{};
+    tall.snapshot(unchanged);
+    EXPECT_EQ(unchanged.tiles, tallState.tiles);
+    EXPECT_TRUE(wide.restore(wideState));
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, LegalMovesMatchBruteForceSearch)
+{
+    using Move = Simulations::TileMatchingPuzzle::Move;
+
+    std::array<Move, 2U * GridWidth * GridHeight> moves{};
+    Simulations::TileMatchingPuzzle::State        state{};
+    for (auto round = 0U; round < 20U; ++round)
+    {
+        // shake up the grid to get different situations
+        EXPECT_TRUE(sut.setTile(round % GridWidth, (round * 3U) % GridHeight, EmptyTile));
+        sut.simulate();
+
+        auto const count = sut.legalMoves(moves);
+        ASSERT_LE(count, moves.size());
+
+        sut.snapshot(state);
+        size_t expectedCount{};
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                for (auto const vertical : {false, true})
+                {
+                    auto const otherX = vertical ? x : (x + 1U);
+                    auto const otherY = vertical ? (y + 1U) : y;
+                    if ((otherX >= GridWidth) || (otherY >= GridHeight))
+                    {
+                        continue;
+                    }
+                    auto const typeA = sut(x, y);
+                    auto const typeB = sut(otherX, otherY);
+                    EXPECT_TRUE(sut.setTile(x, y, typeB));
+                    EXPECT_TRUE(sut.setTile(otherX, otherY, typeA));
+                    auto const collapses = !sut.simulate(false).empty();
+                    EXPECT_TRUE(sut.restore(state));
+                    if (collapses)
+                    {
+                        ASSERT_LT(expectedCount, count) << "x: " << x << " y: " << y << " vertical: " << vertical;
+                        EXPECT_EQ(moves[expectedCount].x, x);
+                        EXPECT_EQ(moves[expectedCount].y, y);
+                        EXPECT_EQ(moves[expectedCount].vertical, vertical);
+                        ++expectedCount;
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(expectedCount, count);
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, LegalMovesOnlyWritesToTheGivenBuffer)
+{
+    using Move = Simulations::TileMatchingPuzzle::Move;
+
+    std::array<Move, 2U * GridWidth * GridHeight> allMoves{};
+    auto const                                    total = sut.legalMoves(allMoves);
+    ASSERT_GT(total, 1U);
+    EXPECT_EQ(sut.legalMoves({}), total);
+
+    std::array<Move, 2U> someMoves{};
+    EXPECT_EQ(sut.legalMoves(someMoves), total);
+    for (auto i = 0U; i < someMoves.size(); ++i)
+    {
+        EXPECT_EQ(someMoves[i].x, allMoves[i].x);
+        EXPECT_EQ(someMoves[i].y, allMoves[i].y);
+        EXPECT_EQ(someMoves[i].vertical, allMoves[i].vertical);
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, CascadesOnlyCheckingChangedRegionsMatchFullScan)
+{
+    using Move = Simulations::TileMatchingPuzzle::Move;
+
+    // the bitboard implementation checks the entire grid in every wave
+    Simulations::TileMatchingPuzzle         puzzle{12U, 10U, 4U, 7U};
+    Simulations::BitboardTileMatchingPuzzle reference{12U, 10U, 4U, 7U};
+    std::array<Move, 2U * 12U * 10U>        moves{};
+    for (auto round = 0U; round < 100U; ++round)
+    {
+        auto const count = puzzle.legalMoves(moves);
+        ASSERT_NE(count, 0U) << "round: " << round;
+        auto const &move   = moves[round % count];
+        auto const  otherX = move.vertical ? move.x : (move.x + 1U);
+        auto const  otherY = move.vertical ? (move.y + 1U) : move.y;
+        auto const  typeA  = reference(move.x, move.y);
+        auto const  typeB  = reference(otherX, otherY);
+        EXPECT_TRUE(reference.setTile(move.x, move.y, typeB));
+        EXPECT_TRUE(reference.setTile(otherX, otherY, typeA));
+        EXPECT_TRUE(puzzle.swapTiles(move));
+
+        auto const expected = reference.simulate();
+        auto const actual   = puzzle.simulate();
+        ASSERT_EQ(actual.size(), expected.size()) << "round: " << round;
+        for (auto c = 0U; c < expected.size(); ++c)
+        {
+            EXPECT_EQ(actual[c].type, expected[c].type) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(actual[c].amount, expected[c].amount) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(actual[c].wave, expected[c].wave) << "round: " << round << " collapse: " << c;
+        }
+        for (auto x = 0U; x < puzzle.width(); ++x)
+        {
+            for (auto y = 0U; y < puzzle.height(); ++y)
+            {
+                ASSERT_EQ(puzzle(x, y), reference(x, y)) << "round: " << round << " x: " << x << " y: " << y;
+            }
+        }
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, SimulatingIntoBufferMatchesSimulate)
+{
+    using Collapse = Simulations::TileMatchingPuzzle::Collapse;
+    using Move     = Simulations::TileMatchingPuzzle::Move;
+
+    Simulations::TileMatchingPuzzle               reference{sut};
+    std::array<Move, 2U * GridWidth * GridHeight> moves{};
+    std::array<Collapse, GridWidth * GridHeight>  collapses{};
+    for (auto round = 0U; round < 50U; ++round)
+    {
+        auto const count = sut.legalMoves(moves);
+        ASSERT_NE(count, 0U) << "round: " << round;
+        EXPECT_TRUE(sut.swapTiles(moves[round % count]));
+        EXPECT_TRUE(reference.swapTiles(moves[round % count]));
+
+        auto const result   = sut.simulate(collapses);
+        auto const expected = reference.simulate();
+        EXPECT_FALSE(result.overflow) << "round: " << round;
+        ASSERT_EQ(result.count, expected.size()) << "round: " << round;
+        for (auto c = 0U; c < expected.size(); ++c)
+        {
+            EXPECT_EQ(collapses[c].type, expected[c].type) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(collapses[c].amount, expected[c].amount) << "round: " << round << " collapse: " << c;
+            EXPECT_EQ(collapses[c].wave, expected[c].wave) << "round: " << round << " collapse: " << c;
+        }
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                ASSERT_EQ(sut(x, y), reference(x, y)) << "round: " << round << " x: " << x << " y: " << y;
+            }
+        }
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, SimulatingIntoBufferDoesNotAllocate)
+{
+    using Collapse = Simulations::TileMatchingPuzzle::Collapse;
+    using Move     = Simulations::TileMatchingPuzzle::Move;
+
+    std::array<Move, 2U * GridWidth * GridHeight> moves{};
+    std::array<Collapse, 4U>                      collapses{};
+    Simulations::TileMatchingPuzzle::State        state{};
+    sut.snapshot(state);
+
+    auto const before = allocationCount.load();
+    for (auto round = 0U; round < 200U; ++round)
+    {
+        auto const count = sut.legalMoves(moves);
+        ASSERT_NE(count, 0U) << "round: " << round;
+        EXPECT_TRUE(sut.swapTiles(moves[round % count]));
+        sut.simulate(collapses);
+        sut.simulate(collapses, false);
+        if ((round % 10U) == 9U)
+        {
+            EXPECT_TRUE(sut.restore(state));
+        }
+    }
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, CompileTimeSizedPuzzleDoesNotAllocate)
+{
+    using Rules  = Simulations::SpecialTileRules;
+    using Puzzle = Simulations::BasicTileMatchingPuzzle<GridWidth, GridHeight, TypeCount, Rules>;
+
+    std::array<Puzzle::Move, 2U * GridWidth * GridHeight> moves{};
+    std::array<Puzzle::Collapse, 4U>                      collapses{};
+    Puzzle::State                                         state{};
+
+    auto const before = allocationCount.load();
+    Puzzle     puzzle{};
+    puzzle.snapshot(state);
+    for (auto round = 0U; round < 200U; ++round)
+    {
+        Puzzle     copy{puzzle};
+        auto const count = copy.legalMoves(moves);
+        ASSERT_NE(count, 0U) << "round: " << round;
+        EXPECT_TRUE(copy.swapTiles(moves[round % count]));
+        copy.simulate(collapses);
+        puzzle = copy;
+        if ((round % 10U) == 9U)
+        {
+            EXPECT_TRUE(puzzle.restore(state));
+        }
+    }
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, SimulatingIntoTooSmallBufferReportsOverflow)
+{
+    using Collapse = Simulations::TileMatchingPuzzle::Collapse;
+
+    // same setup as CollapseOfTwoSeparateLines
+    fillGrid();
+    EXPECT_TRUE(sut.setTile(3U, 2U, 5U));
+    EXPECT_TRUE(sut.setTile(4U, 2U, 5U));
+    EXPECT_TRUE(sut.setTile(5U, 2U, 5U));
+    EXPECT_TRUE(sut.setTile(2U, 6U, 3U));
+    EXPECT_TRUE(sut.setTile(2U, 7U, 3U));
+
+    replicate();
+    stateReplica[2U][2U] = EmptyTile;
+    stateReplica[3U][2U] = EmptyTile;
+    stateReplica[4U][2U] = EmptyTile;
+    stateReplica[5U][2U] = EmptyTile;
+    stateReplica[2U][5U] = EmptyTile;
+    stateReplica[2U][6U] = EmptyTile;
+    stateReplica[2U][7U] = EmptyTile;
+    simulateGravity();
+
+    std::array<Collapse, 1U> collapses{};
+    auto const               result = sut.simulate(collapses, false);
+    EXPECT_TRUE(result.overflow);
+    ASSERT_EQ(result.count, 1U);
+    EXPECT_EQ(collapses[0U].type, 5U);
+    EXPECT_EQ(collapses[0U].amount, 4U);
+    EXPECT_EQ(collapses[0U].wave, 0U);
+
+    // the grid is simulated completely regardless
+    compareReplica(false);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, HashOnlyDependsOnTheGrid)
+{
+    auto const original = sut.hash();
+    auto const type     = sut(3U, 4U);
+    EXPECT_TRUE(sut.setTile(3U, 4U, (type % TypeCount) + 1U));
+    EXPECT_NE(sut.hash(), original);
+    EXPECT_TRUE(sut.setTile(3U, 4U, type));
+    EXPECT_EQ(sut.hash(), original);
+
+    // reaching the same grid using a different puzzle and random number generator results in the same hash
+    Simulations::TileMatchingPuzzle other{GridWidth, GridHeight, TypeCount, 1234U};
+    EXPECT_NE(other.hash(), original);
+    for (auto x = 0U; x < GridWidth; ++x)
+    {
+        for (auto y = 0U; y < GridHeight; ++y)
+        {
+            EXPECT_TRUE(other.setTile(x, y, sut(x, y)));
+        }
+    }
+    EXPECT_EQ(other.hash(), original);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, HashDependsOnGridSizeAndTypeCount)
+{
+    Simulations::TileMatchingPuzzle square{8U, 8U, TypeCount};
+    Simulations::TileMatchingPuzzle wide{16U, 4U, TypeCount};
+    Simulations::TileMatchingPuzzle moreTypes{8U, 8U, TypeCount + 1U};
+    // all grids get the same tiles in the order they are stored in
+    for (auto i = 0U; i < 64U; ++i)
+    {
+        auto const type = static_cast<std::uint8_t>((i % TypeCount) + 1U);
+        ASSERT_TRUE(square.setTile(i / 8U, i % 8U, type));
+        ASSERT_TRUE(wide.setTile(i / 4U, i % 4U, type));
+        ASSERT_TRUE(moreTypes.setTile(i / 8U, i % 8U, type));
+    }
+    EXPECT_NE(square.hash(), wide.hash());
+    EXPECT_NE(square.hash(), moreTypes.hash());
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, HashIsUpdatedBySwappingAndSimulating)
+{
+    using Hashed = Simulations::BasicTileMatchingPuzzle<Simulations::DynamicExtent,
+                                                        Simulations::DynamicExtent,
+                                                        Simulations::DynamicExtent,
+                                                        Simulations::PlainRules,
+                                                        true>;
+    using Move   = Hashed::Move;
+
+    // the hashed puzzle updates its hash incrementally, restoring a snapshot calculates the hash from scratch and the
+    // unhashed puzzle calculates it on demand
+    Hashed                                        hashed{GridWidth, GridHeight, TypeCount};
+    Hashed                                        reference{GridWidth, GridHeight, TypeCount};
+    Hashed::State                                 state{};
+    std::array<Move, 2U * GridWidth * GridHeight> moves{};
+    auto const                                    compareHashes = [&](std::uint32_t const round) {
+        hashed.snapshot(state);
+        EXPECT_TRUE(reference.restore(state));
+        EXPECT_EQ(hashed.hash(), reference.hash()) << "round: " << round;
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                EXPECT_TRUE(sut.setTile(x, y, hashed(x, y)));
+            }
+        }
+        EXPECT_EQ(hashed.hash(), sut.hash()) << "round: " << round;
+    };
+    for (auto round = 0U; round < 100U; ++round)
+    {
+        auto const count = hashed.legalMoves(moves);
+        ASSERT_NE(count, 0U) << "round: " << round;
+        EXPECT_TRUE(hashed.swapTiles(moves[round % count]));
+        compareHashes(round);
+
+        hashed.simulate((round % 3U) != 0U);
+        compareHashes(round);
+        if ((round % 3U) == 0U)
+        {
+            // refill the grid for the next round
+            hashed.simulate();
+        }
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, PeekingGridWithoutLinesFindsNothing)
+{
+    fillGrid();
+    EXPECT_EQ(sut.peekCollapses(), 0U);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, PeekingCountsTilesOfTheFirstWave)
+{
+    // same setup as CollapseOfTwoSeparateLines
+    fillGrid();
+    EXPECT_TRUE(sut.setTile(3U, 2U, 5U));
+    EXPECT_TRUE(sut.setTile(4U, 2U, 5U));
+    EXPECT_TRUE(sut.setTile(5U, 2U, 5U));
+    EXPECT_TRUE(sut.setTile(2U, 6U, 3U));
+    EXPECT_TRUE(sut.setTile(2U, 7U, 3U));
+
+    replicate();
+    EXPECT_EQ(sut.peekCollapses(), 7U);
+    compareReplica(false);
+}
+
+TEST_F(SimulationsTileMatchingPuzzle, PeekingMatchesFirstWaveOfSimulation)
+{
+    using Move = Simulations::TileMatchingPuzzle::Move;
+
+    // grids taller than 64 rows are peeked without row masks
+    for (auto const height : {GridHeight, std::uint8_t{70U}})
+    {
+        Simulations::TileMatchingPuzzle        puzzle{GridWidth, height, TypeCount};
+        std::vector<Move>                      moves(2U * GridWidth * height);
+        Simulations::TileMatchingPuzzle::State state{};
+        for (auto round = 0U; round < 20U; ++round)
+        {
+            auto const count = puzzle.legalMoves(moves);
+            ASSERT_NE(count, 0U) << "height: " << height << " round: " << round;
+            for (auto m = 0U; m < count; ++m)
+            {
+                puzzle.snapshot(state);
+                EXPECT_TRUE(puzzle.swapTiles(moves[m]));
+
+                auto const before = allocationCount.load();
+                auto const peeked = puzzle.peekCollapses();
+                EXPECT_EQ(allocationCount.load(), before);
+
+                size_t expected{};
+                for (auto const &collapse : puzzle.simulate(false))
+                {
+                    expected += (collapse.wave == 0U) ? collapse.amount : 0U;
+                }
+                EXPECT_EQ(peeked, expected) << "height: " << height << " round: " << round << " move: " << m;
+                EXPECT_TRUE(puzzle.restore(state));
+            }
+            EXPECT_TRUE(puzzle.swapTiles(moves[round % count]));
+            puzzle.simulate();
+        }
+    }
+}
+
 } // namespace Terrahertz::UnitTests
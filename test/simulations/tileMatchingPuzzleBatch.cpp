@@ -0,0 +1,188 @@
+#include "THzAutoGaming/simulations/tileMatchingPuzzleBatch.hpp"
+
+#include "THzAutoGaming/simulations/tileMatchingPuzzle.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsTileMatchingPuzzleBatch : public testing::Test
+{
+    static constexpr std::uint8_t  GridWidth{8U};
+    static constexpr std::uint8_t  GridHeight{8U};
+    static constexpr std::uint8_t  TypeCount{5U};
+    static constexpr std::uint32_t BoardCount{4U};
+
+    Simulations::TileMatchingPuzzleBatch sut{GridWidth, GridHeight, TypeCount, BoardCount};
+
+    /// @brief Randomly alters tiles of all boards and compares the results to one TileMatchingPuzzle per board.
+    ///
+    /// @param width The width of the grids.
+    /// @param height The height of the grids.
+    /// @param typeCount The number of types of tiles.
+    /// @param boardCount The number of boards in the batch.
+    /// @param refill Flag passed on to simulate.
+    void checkEquivalence(std::uint8_t const  width,
+                          std::uint8_t const  height,
+                          std::uint8_t const  typeCount,
+                          std::uint32_t const boardCount,
+                          bool const          refill)
+    {
+        Simulations::TileMatchingPuzzleBatch         batch{width, height, typeCount, boardCount};
+        std::vector<Simulations::TileMatchingPuzzle> references{};
+        Simulations::TileMatchingPuzzle::State       state{};
+        for (auto board = 0U; board < boardCount; ++board)
+        {
+            references.emplace_back(width, height, typeCount, board);
+            references.back().snapshot(state);
+            ASSERT_TRUE(batch.restore(board, state));
+        }
+
+        std::mt19937                                 changes{42U};
+        std::uniform_int_distribution<std::uint32_t> xDist{0U, width - 1U};
+        std::uniform_int_distribution<std::uint32_t> yDist{0U, height - 1U};
+        std::uniform_int_distribution<std::uint32_t> typeDist{0U, typeCount};
+        for (auto round = 0U; round < 50U; ++round)
+        {
+            for (auto board = 0U; board < boardCount; ++board)
+            {
+                for (auto i = 0U; i < 4U; ++i)
+                {
+                    auto const x    = static_cast<std::uint8_t>(xDist(changes));
+                    auto const y    = static_cast<std::uint8_t>(yDist(changes));
+                    auto const type = static_cast<std::uint8_t>(typeDist(changes));
+                    ASSERT_TRUE(batch.setTile(board, x, y, type));
+                    ASSERT_TRUE(references[board].setTile(x, y, type));
+                }
+            }
+
+            auto const summaries = batch.simulate(refill);
+            ASSERT_EQ(summaries.size(), boardCount);
+            for (auto board = 0U; board < boardCount; ++board)
+            {
+                std::uint32_t           amount{};
+                std::set<std::uint16_t> waves{};
+                for (auto const &collapse : references[board].simulate(refill))
+                {
+                    amount += collapse.amount;
+                    waves.insert(collapse.wave);
+                }
+                EXPECT_EQ(summaries[board].amount, amount) << "round: " << round << " board: " << board;
+                EXPECT_EQ(summaries[board].waves, waves.size()) << "round: " << round << " board: " << board;
+                for (auto x = 0U; x < width; ++x)
+                {
+                    for (auto y = 0U; y < height; ++y)
+                    {
+                        ASSERT_EQ(batch(board, x, y), references[board](x, y))
+                            << "round: " << round << " board: " << board << " x: " << x << " y: " << y;
+                    }
+                }
+                EXPECT_EQ(batch.rng(board), references[board].rng()) << "round: " << round << " board: " << board;
+            }
+        }
+    }
+};
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, ValidStateAfterConstruction)
+{
+    EXPECT_EQ(sut.width(), GridWidth);
+    EXPECT_EQ(sut.height(), GridHeight);
+    EXPECT_EQ(sut.typeCount(), TypeCount);
+    EXPECT_EQ(sut.boardCount(), BoardCount);
+    for (auto board = 0U; board < BoardCount; ++board)
+    {
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                ASSERT_EQ(sut(board, x, y), Simulations::TileMatchingPuzzleBatch::EmptyTile);
+            }
+        }
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, OutOfBoundAccessIsRejected)
+{
+    EXPECT_EQ(sut(BoardCount, 0U, 0U), Simulations::TileMatchingPuzzleBatch::ErrorTile);
+    EXPECT_EQ(sut(0U, GridWidth, 0U), Simulations::TileMatchingPuzzleBatch::ErrorTile);
+    EXPECT_EQ(sut(0U, 0U, GridHeight), Simulations::TileMatchingPuzzleBatch::ErrorTile);
+    EXPECT_FALSE(sut.setTile(BoardCount, 0U, 0U, 1U));
+    EXPECT_FALSE(sut.setTile(0U, 0U, 0U, TypeCount + 1U));
+    EXPECT_FALSE(sut.swapTiles(BoardCount, {0U, 0U, false}));
+    EXPECT_FALSE(sut.swapTiles(0U, {GridWidth - 1U, 0U, false}));
+
+    Simulations::TileMatchingPuzzleBatch::State state{};
+    EXPECT_FALSE(sut.snapshot(BoardCount, state));
+    EXPECT_FALSE(sut.restore(BoardCount, state));
+    EXPECT_FALSE(sut.restore(0U, state));
+}
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, SettingAndSwappingOnlyAffectsTheGivenBoard)
+{
+    EXPECT_TRUE(sut.setTile(1U, 3U, 3U, 2U));
+    EXPECT_TRUE(sut.setTile(1U, 4U, 3U, 4U));
+    EXPECT_TRUE(sut.swapTiles(1U, {3U, 3U, false}));
+    EXPECT_EQ(sut(1U, 3U, 3U), 4U);
+    EXPECT_EQ(sut(1U, 4U, 3U), 2U);
+    for (auto const board : {0U, 2U, 3U})
+    {
+        EXPECT_EQ(sut(board, 3U, 3U), Simulations::TileMatchingPuzzleBatch::EmptyTile);
+        EXPECT_EQ(sut(board, 4U, 3U), Simulations::TileMatchingPuzzleBatch::EmptyTile);
+    }
+}
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, SnapshotReturnsRestoredState)
+{
+    Simulations::TileMatchingPuzzle        puzzle{GridWidth, GridHeight, TypeCount};
+    Simulations::TileMatchingPuzzle::State expected{};
+    Simulations::TileMatchingPuzzle::State actual{};
+    puzzle.snapshot(expected);
+    ASSERT_TRUE(sut.restore(2U, expected));
+    ASSERT_TRUE(sut.snapshot(2U, actual));
+    EXPECT_EQ(actual.tiles, expected.tiles);
+    EXPECT_EQ(actual.rng, expected.rng);
+    ASSERT_TRUE(sut.snapshot(1U, actual));
+    EXPECT_EQ(actual.tiles, std::vector<std::uint8_t>(expected.tiles.size(), 0U));
+}
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, RestoringAllBoardsCopiesTheStateToEachBoard)
+{
+    Simulations::TileMatchingPuzzle        puzzle{GridWidth, GridHeight, TypeCount};
+    Simulations::TileMatchingPuzzle::State expected{};
+    Simulations::TileMatchingPuzzle::State actual{};
+    puzzle.snapshot(expected);
+    ASSERT_TRUE(sut.restore(expected));
+    for (auto board = 0U; board < BoardCount; ++board)
+    {
+        ASSERT_TRUE(sut.snapshot(board, actual));
+        EXPECT_EQ(actual.tiles, expected.tiles);
+        EXPECT_EQ(actual.rng, expected.rng);
+    }
+    EXPECT_FALSE(sut.restore(Simulations::TileMatchingPuzzle::State{}));
+
+    // a grid with the same number of tiles but a different shape does not fit either
+    Simulations::TileMatchingPuzzle        other{GridWidth * 2U, GridHeight / 2U, TypeCount};
+    Simulations::TileMatchingPuzzle::State otherState{};
+    other.snapshot(otherState);
+    EXPECT_FALSE(sut.restore(otherState));
+    EXPECT_FALSE(sut.restore(0U, otherState));
+}
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, SameResultsAsTileMatchingPuzzleWithoutRefill)
+{
+    checkEquivalence(8U, 8U, 5U, 37U, false);
+    checkEquivalence(9U, 7U, 3U, 5U, false);
+}
+
+TEST_F(SimulationsTileMatchingPuzzleBatch, SameResultsAsTileMatchingPuzzleWithRefill)
+{
+    checkEquivalence(8U, 8U, 5U, 37U, true);
+    checkEquivalence(12U, 12U, 3U, 64U, true);
+    checkEquivalence(7U, 10U, 4U, 3U, true);
+}
+
+} // namespace Terrahertz::UnitTests
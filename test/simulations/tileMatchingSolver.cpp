@@ -0,0 +1,179 @@
+#include "THzAutoGaming/simulations/tileMatchingSolver.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsTileMatchingSolver : public testing::Test
+{
+    static constexpr std::uint8_t GridWidth{8U};
+    static constexpr std::uint8_t GridHeight{8U};
+    static constexpr std::uint8_t TypeCount{5U};
+
+    static constexpr std::chrono::nanoseconds Unlimited{std::chrono::hours{1}};
+
+    Simulations::TileMatchingPuzzle puzzle{GridWidth, GridHeight, TypeCount};
+
+    /// @brief Fills the grid with a pattern without lines and places a line of 5 that is completed by a single move.
+    ///
+    /// @remarks The pattern only uses the types 1 to 4, type 5 is reserved for the line.
+    void placeLineOf5()
+    {
+        for (auto x = 0U; x < GridWidth; ++x)
+        {
+            for (auto y = 0U; y < GridHeight; ++y)
+            {
+                auto const type = static_cast<std::uint8_t>(((x + (2U * y)) % 4U) + 1U);
+                ASSERT_TRUE(puzzle.setTile(static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), type));
+            }
+        }
+        ASSERT_TRUE(puzzle.setTile(0U, 0U, 5U));
+        ASSERT_TRUE(puzzle.setTile(1U, 0U, 5U));
+        ASSERT_TRUE(puzzle.setTile(2U, 1U, 5U));
+        ASSERT_TRUE(puzzle.setTile(3U, 0U, 5U));
+        ASSERT_TRUE(puzzle.setTile(4U, 0U, 5U));
+    }
+};
+
+TEST_F(SimulationsTileMatchingSolver, NoResultBeforeSearch)
+{
+    Simulations::TileMatchingSolver sut{};
+    EXPECT_FALSE(sut.best().valid);
+    EXPECT_EQ(sut.best().depth, 0U);
+    EXPECT_TRUE(sut.search(Unlimited));
+}
+
+TEST_F(SimulationsTileMatchingSolver, GridWithoutLegalMovesGivesInvalidResult)
+{
+    Simulations::TileMatchingPuzzle distinct{4U, 4U, 16U};
+    for (auto x = 0U; x < 4U; ++x)
+    {
+        for (auto y = 0U; y < 4U; ++y)
+        {
+            auto const type = static_cast<std::uint8_t>((x * 4U) + y + 1U);
+            ASSERT_TRUE(distinct.setTile(static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), type));
+        }
+    }
+
+    Simulations::TileMatchingSolver sut{};
+
+    auto const &result = sut.solve(distinct, Unlimited);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(result.nodes, 0U);
+}
+
+TEST_F(SimulationsTileMatchingSolver, FindsMoveCompletingLongestLine)
+{
+    placeLineOf5();
+
+    Simulations::TileMatchingSolver sut{{.maxDepth = 1U, .chanceSamples = 8U}};
+
+    auto const &result = sut.solve(puzzle, Unlimited);
+    ASSERT_TRUE(result.valid);
+    EXPECT_EQ(result.depth, 1U);
+    EXPECT_EQ(result.move.x, 2U);
+    EXPECT_EQ(result.move.y, 0U);
+    EXPECT_TRUE(result.move.vertical);
+    EXPECT_GE(result.value, 5.0);
+}
+
+TEST_F(SimulationsTileMatchingSolver, DeeperSearchExpectsHigherScore)
+{
+    Simulations::TileMatchingSolver shallow{{.maxDepth = 1U}};
+    Simulations::TileMatchingSolver deep{{.maxDepth = 2U}};
+
+    auto const &shallowResult = shallow.solve(puzzle, Unlimited);
+    auto const &deepResult    = deep.solve(puzzle, Unlimited);
+    ASSERT_TRUE(shallowResult.valid);
+    ASSERT_TRUE(deepResult.valid);
+    EXPECT_EQ(deepResult.depth, 2U);
+    EXPECT_GT(deepResult.value, shallowResult.value);
+    EXPECT_GT(deepResult.nodes, shallowResult.nodes);
+}
+
+TEST_F(SimulationsTileMatchingSolver, SearchDoesNotChangeThePuzzle)
+{
+    Simulations::TileMatchingPuzzle::State before{};
+    puzzle.snapshot(before);
+
+    Simulations::TileMatchingSolver sut{{.maxDepth = 2U}};
+    sut.solve(puzzle, Unlimited);
+
+    Simulations::TileMatchingPuzzle::State after{};
+    puzzle.snapshot(after);
+    EXPECT_EQ(before.tiles, after.tiles);
+    EXPECT_EQ(before.rng, after.rng);
+}
+
+TEST_F(SimulationsTileMatchingSolver, SearchStopsWhenBudgetIsUsedUp)
+{
+    Simulations::TileMatchingSolver sut{{.maxDepth = 64U}};
+    sut.setRoot(puzzle);
+
+    EXPECT_FALSE(sut.search(Unlimited, 1000U));
+    // the first legal move is returned even if no iteration was completed
+    EXPECT_TRUE(sut.best().valid);
+    EXPECT_LT(sut.best().depth, 64U);
+    EXPECT_LT(sut.best().nodes, 2000U);
+}
+
+TEST_F(SimulationsTileMatchingSolver, InterruptedSearchContinuesWithSameResult)
+{
+    Simulations::TileMatchingSolver::Parameters const parameters{.maxDepth = 2U};
+    Simulations::TileMatchingSolver                   expected{parameters};
+    expected.solve(puzzle, Unlimited);
+
+    // a budget of a single node is shorter than any iteration, including the first one
+    for (auto const nodes : {size_t{1U}, size_t{100U}})
+    {
+        Simulations::TileMatchingSolver sut{parameters};
+        sut.setRoot(puzzle);
+        auto calls = 0U;
+        while (!sut.search(Unlimited, nodes))
+        {
+            ++calls;
+            ASSERT_LT(calls, expected.best().nodes);
+        }
+        EXPECT_GT(calls, 0U);
+        EXPECT_EQ(sut.best().depth, expected.best().depth);
+        EXPECT_EQ(sut.best().value, expected.best().value);
+        EXPECT_EQ(sut.best().move.x, expected.best().move.x);
+        EXPECT_EQ(sut.best().move.y, expected.best().move.y);
+        EXPECT_EQ(sut.best().move.vertical, expected.best().move.vertical);
+    }
+}
+
+TEST_F(SimulationsTileMatchingSolver, ShortTimeBudgetStillReachesMaximumDepth)
+{
+    Simulations::TileMatchingSolver sut{{.maxDepth = 1U}};
+    sut.setRoot(puzzle);
+
+    auto calls = 0U;
+    while (!sut.search(std::chrono::nanoseconds{}))
+    {
+        ++calls;
+        ASSERT_LT(calls, 1000U);
+    }
+    EXPECT_EQ(sut.best().depth, 1U);
+}
+
+TEST_F(SimulationsTileMatchingSolver, TranspositionTableIsReusedBetweenSearches)
+{
+    Simulations::TileMatchingSolver sut{{.maxDepth = 2U}};
+
+    auto const first = sut.solve(puzzle, Unlimited);
+    ASSERT_GT(first.nodes, 0U);
+
+    auto const second = sut.solve(puzzle, Unlimited);
+    EXPECT_LT(second.nodes, first.nodes);
+    EXPECT_EQ(second.value, first.value);
+
+    sut.clear();
+    auto const third = sut.solve(puzzle, Unlimited);
+    EXPECT_EQ(third.nodes, first.nodes);
+    EXPECT_EQ(third.value, first.value);
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,125 @@
+#include "THzAutoGaming/simulations/transpositionCache.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+struct SimulationsTranspositionCache : public testing::Test
+{
+    Simulations::TranspositionCache<> sut{1000U};
+
+    /// @brief Derives an outcome from the given key, so readers can verify the value belongs to the key.
+    ///
+    /// @param key The key to derive the outcome from.
+    /// @return The outcome.
+    static Simulations::CollapseOutcome outcomeOf(std::uint64_t const key) noexcept
+    {
+        return Simulations::CollapseOutcome{.amount    = static_cast<std::uint32_t>(key * 3U),
+                                            .waves     = static_cast<std::uint16_t>(key >> 32U),
+                                            .collapses = static_cast<std::uint16_t>(key >> 48U)};
+    }
+};
+
+TEST_F(SimulationsTranspositionCache, SizeIsRoundedUpToPowerOfTwo) { EXPECT_EQ(sut.size(), 1024U); }
+
+TEST_F(SimulationsTranspositionCache, EmptyCacheFindsNothing)
+{
+    Simulations::CollapseOutcome outcome{};
+    EXPECT_FALSE(sut.lookup(0U, outcome));
+    EXPECT_FALSE(sut.lookup(1U, outcome));
+    EXPECT_FALSE(sut.lookup(~std::uint64_t{} - 1U, outcome));
+}
+
+TEST_F(SimulationsTranspositionCache, StoredValueIsFound)
+{
+    sut.store(0x1234'5678'9ABC'DEF0ULL, outcomeOf(42U));
+
+    Simulations::CollapseOutcome outcome{};
+    ASSERT_TRUE(sut.lookup(0x1234'5678'9ABC'DEF0ULL, outcome));
+    EXPECT_EQ(outcome.amount, outcomeOf(42U).amount);
+    EXPECT_EQ(outcome.waves, outcomeOf(42U).waves);
+    EXPECT_EQ(outcome.collapses, outcomeOf(42U).collapses);
+    EXPECT_FALSE(sut.lookup(0x1234'5678'9ABC'DEF1ULL, outcome));
+}
+
+TEST_F(SimulationsTranspositionCache, KeyMatchingEmptySlotsIsNeverFound)
+{
+    Simulations::CollapseOutcome outcome{};
+    EXPECT_FALSE(sut.lookup(~std::uint64_t{}, outcome));
+
+    sut.store(~std::uint64_t{}, outcomeOf(42U));
+    EXPECT_FALSE(sut.lookup(~std::uint64_t{}, outcome));
+}
+
+TEST_F(SimulationsTranspositionCache, KeysOfTheSameSlotReplaceEachOther)
+{
+    auto const first  = 5U;
+    auto const second = first + sut.size();
+    sut.store(first, outcomeOf(first));
+    sut.store(second, outcomeOf(second));
+
+    Simulations::CollapseOutcome outcome{};
+    EXPECT_FALSE(sut.lookup(first, outcome));
+    ASSERT_TRUE(sut.lookup(second, outcome));
+    EXPECT_EQ(outcome.amount, outcomeOf(second).amount);
+}
+
+TEST_F(SimulationsTranspositionCache, ClearRemovesAllValues)
+{
+    for (auto key = 0U; key < 100U; ++key)
+    {
+        sut.store(key, outcomeOf(key));
+    }
+    sut.clear();
+
+    Simulations::CollapseOutcome outcome{};
+    for (auto key = 0U; key < 100U; ++key)
+    {
+        EXPECT_FALSE(sut.lookup(key, outcome)) << "key: " << key;
+    }
+}
+
+TEST_F(SimulationsTranspositionCache, ConcurrentAccessNeverReturnsValuesOfOtherKeys)
+{
+    Simulations::TranspositionCache<> cache{64U};
+    std::atomic<size_t>               mismatches{};
+    std::atomic<size_t>               hits{};
+    std::vector<std::thread>          threads{};
+    for (auto t = 0U; t < 4U; ++t)
+    {
+        threads.emplace_back([&, t]() noexcept {
+            for (std::uint64_t i = 0U; i < 200000U; ++i)
+            {
+                // few slots and many keys make sure the threads constantly overwrite each other
+                auto const key = ((i * 0x9E3779B97F4A7C15ULL) >> 8U) + t;
+                if ((i % 2U) == 0U)
+                {
+                    cache.store(key, outcomeOf(key));
+                }
+                Simulations::CollapseOutcome outcome{};
+                if (cache.lookup(key, outcome))
+                {
+                    ++hits;
+                    auto const expected = outcomeOf(key);
+                    if ((outcome.amount != expected.amount) || (outcome.waves != expected.waves) ||
+                        (outcome.collapses != expected.collapses))
+                    {
+                        ++mismatches;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_GT(hits.load(), 0U);
+    EXPECT_EQ(mismatches.load(), 0U);
+}
+
+} // namespace Terrahertz::UnitTests
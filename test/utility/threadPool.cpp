@@ -0,0 +1,48 @@
+#include "THzAutoGaming/utility/threadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+TEST(UtilityThreadPool, DefaultConstructionCreatesAtLeastOneThread)
+{
+    ThreadPool sut{};
+    EXPECT_GE(sut.threadCount(), 1U);
+}
+
+TEST(UtilityThreadPool, ThreadCountAsGiven)
+{
+    ThreadPool sut{3U};
+    EXPECT_EQ(sut.threadCount(), 3U);
+}
+
+TEST(UtilityThreadPool, RunExecutesTaskOnEveryThreadOnce)
+{
+    ThreadPool                 sut{4U};
+    std::vector<std::uint32_t> calls(sut.threadCount());
+    for (auto round = 1U; round <= 10U; ++round)
+    {
+        sut.run([&](std::uint32_t const index) noexcept { ++calls[index]; });
+        for (auto const c : calls)
+        {
+            ASSERT_EQ(c, round);
+        }
+    }
+}
+
+TEST(UtilityThreadPool, RunWaitsForAllThreadsToFinish)
+{
+    ThreadPool                 sut{4U};
+    std::atomic<std::uint32_t> finished{};
+    sut.run([&](std::uint32_t const) noexcept {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        ++finished;
+    });
+    EXPECT_EQ(finished.load(), sut.threadCount());
+}
+
+} // namespace Terrahertz::UnitTests
@@ -0,0 +1,104 @@
+#include "THzAutoGaming/utility/xoshiro256.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace Terrahertz::UnitTests {
+
+TEST(UtilityXoshiro256, ProducesReferenceSequence)
+{
+    Xoshiro256 sut{Xoshiro256::StateType{1U, 2U, 3U, 4U}};
+    EXPECT_EQ(sut(), 11520U);
+    EXPECT_EQ(sut(), 0U);
+    EXPECT_EQ(sut(), 1509978240U);
+    EXPECT_EQ(sut(), 1215971899390074240U);
+}
+
+TEST(UtilityXoshiro256, SameSeedProducesSameSequence)
+{
+    Xoshiro256 sutA{1234U};
+    Xoshiro256 sutB{1234U};
+    EXPECT_EQ(sutA, sutB);
+    for (auto i = 0U; i < 100U; ++i)
+    {
+        ASSERT_EQ(sutA(), sutB());
+    }
+}
+
+TEST(UtilityXoshiro256, ReseedingRestartsSequence)
+{
+    Xoshiro256 sut{1234U};
+    auto const first = sut();
+    sut();
+    sut.seed(1234U);
+    EXPECT_EQ(sut(), first);
+}
+
+TEST(UtilityXoshiro256, DifferentSeedsProduceDifferentSequences)
+{
+    Xoshiro256 sutA{1U};
+    Xoshiro256 sutB{2U};
+    EXPECT_NE(sutA, sutB);
+    EXPECT_NE(sutA(), sutB());
+}
+
+TEST(UtilityXoshiro256, SplitReturnsCurrentStreamAndJumpsAhead)
+{
+    Xoshiro256 sut{};
+    Xoshiro256 copy{sut};
+    auto       child = sut.split();
+    EXPECT_EQ(child, copy);
+    EXPECT_NE(sut, copy);
+
+    copy.jump();
+    EXPECT_EQ(sut, copy);
+
+    // the streams do not overlap within the first values
+    std::vector<std::uint64_t> childValues{};
+    for (auto i = 0U; i < 1000U; ++i)
+    {
+        childValues.emplace_back(child());
+    }
+    for (auto i = 0U; i < 1000U; ++i)
+    {
+        auto const value = sut();
+        for (auto const c : childValues)
+        {
+            ASSERT_NE(value, c);
+        }
+    }
+}
+
+TEST(UtilityXoshiro256, BoundedStaysInRangeAndCoversIt)
+{
+    Xoshiro256                 sut{};
+    std::vector<std::uint32_t> histogram(7U);
+    for (auto i = 0U; i < 7000U; ++i)
+    {
+        auto const value = sut.bounded(7U);
+        ASSERT_LT(value, 7U);
+        ++histogram[value];
+    }
+    for (auto const count : histogram)
+    {
+        EXPECT_GT(count, 800U);
+        EXPECT_LT(count, 1200U);
+    }
+    EXPECT_EQ(sut.bounded(1U), 0U);
+}
+
+TEST(UtilityXoshiro256, UsableWithStandardDistributions)
+{
+    Xoshiro256                              sut{};
+    std::uniform_int_distribution<unsigned> distribution{1U, 6U};
+    for (auto i = 0U; i < 100U; ++i)
+    {
+        auto const value = distribution(sut);
+        ASSERT_GE(value, 1U);
+        ASSERT_LE(value, 6U);
+    }
+}
+
+} // namespace Terrahertz::UnitTests